@@ -0,0 +1,477 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// MANET routing protocol comparison
+//
+// nNodes 802.11b ad hoc nodes move with RandomWaypoint (0-20 m/s, no
+// pause) in a 300 x 1500 m area. Nodes 0..nSinks-1 are sinks, and node
+// i + nSinks sends a 2048 bps stream of 64-byte UDP packets to sink i.
+// The streams start between 100 s and 101 s. Receive rate (kbps) and
+// packets received are sampled every second.
+//
+// Every protocol x nodes x seed cell runs in its own worker process. The
+// mobility streams are fixed, so all protocols see the same trajectories
+// for a given node count and seed. Each run writes the per-second
+// "time rate packets sinks protocol txPower" file used by plotter.plot
+// (AODV.csv, ... when the grid has a single node count and seed). The
+// runs are then merged into one typed results file. A per-flow breakdown
+// of every run is written next to it as <run>.flows.
+//
+// With --traceFile the trajectories are generated once per node count and
+// seed, before the workers start, into a memory-mapped waypoint trace
+// (trace-mobility.h). All protocol runs then play back the same file.
+//
+// ./ns3 run "manet-routing-compare --nodes=50 --seeds=10"
+
+#include "trace-mobility.h"
+
+#include "../parallel-runs.h"
+#include "../throughput-collector.h"
+
+#include "ns3/aodv-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/dsdv-module.h"
+#include "ns3/dsr-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/olsr-module.h"
+#include "ns3/wifi-module.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("ManetRoutingCompare");
+
+static const std::string g_speed =
+    "ns3::UniformRandomVariable[Min=0.0|Max=20.0]"; //!< RandomWaypoint speed (m/s)
+static const std::string g_pause =
+    "ns3::ConstantRandomVariable[Constant=0.0]"; //!< RandomWaypoint pause (s)
+
+/**
+ * \return the start position and waypoint allocator of the 300 x 1500 m area
+ */
+static Ptr<PositionAllocator>
+CreateWaypointAllocator()
+{
+    ObjectFactory pos;
+    pos.SetTypeId("ns3::RandomRectanglePositionAllocator");
+    pos.Set("X", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=300.0]"));
+    pos.Set("Y", StringValue("ns3::UniformRandomVariable[Min=0.0|Max=1500.0]"));
+    return pos.Create()->GetObject<PositionAllocator>();
+}
+
+/**
+ * \param spec Random variable in attribute syntax, e.g. g_speed.
+ * \param stream Stream index to assign.
+ * \return the random variable
+ */
+static Ptr<RandomVariableStream>
+CreateVariable(const std::string& spec, int64_t stream)
+{
+    ObjectFactory factory;
+    std::istringstream is(spec);
+    is >> factory;
+    Ptr<RandomVariableStream> rv = factory.Create<RandomVariableStream>();
+    rv->SetStream(stream);
+    return rv;
+}
+
+/**
+ * One run of the comparison scenario.
+ */
+class RoutingExperiment
+{
+  public:
+    /**
+     * \param protocol Routing protocol: AODV, OLSR, DSDV or DSR.
+     * \param nNodes Number of nodes.
+     * \param nSinks Number of sinks (and sources).
+     * \param txp Transmit power (dBm).
+     * \param totalTime Simulated time (seconds).
+     * \param traceFile Waypoint trace to play back; empty for RandomWaypoint.
+     * \param traceStreams Number of RNG streams used to compile \p traceFile;
+     *        the run's own random variables start after them.
+     */
+    RoutingExperiment(const std::string& protocol,
+                      uint32_t nNodes,
+                      uint32_t nSinks,
+                      double txp,
+                      double totalTime,
+                      const std::string& traceFile,
+                      int64_t traceStreams);
+
+    /**
+     * Build the scenario and run it.
+     *
+     * \param fileName Per-second output file.
+     * \param flowsFile Per-flow ThroughputCollector output file.
+     * \return false if an output file cannot be written.
+     */
+    bool Run(const std::string& fileName, const std::string& flowsFile);
+
+  private:
+    /**
+     * Write one per-second output line (ThroughputCollector bucket callback).
+     *
+     * \param now Bucket end time.
+     * \param bytes Bytes received by all sinks in the bucket.
+     * \param packets Packets received by all sinks in the bucket.
+     */
+    void WriteBucket(Time now, uint64_t bytes, uint64_t packets);
+
+    std::string m_protocol;     //!< routing protocol name
+    uint32_t m_nNodes;          //!< number of nodes
+    uint32_t m_nSinks;          //!< number of sinks
+    double m_txp;               //!< transmit power (dBm)
+    double m_totalTime;         //!< simulated time (seconds)
+    std::string m_traceFile;    //!< waypoint trace, or empty
+    int64_t m_traceStreams;     //!< RNG streams used to compile m_traceFile
+    std::ofstream m_output;     //!< per-second output file
+};
+
+RoutingExperiment::RoutingExperiment(const std::string& protocol,
+                                     uint32_t nNodes,
+                                     uint32_t nSinks,
+                                     double txp,
+                                     double totalTime,
+                                     const std::string& traceFile,
+                                     int64_t traceStreams)
+    : m_protocol(protocol),
+      m_nNodes(nNodes),
+      m_nSinks(nSinks),
+      m_txp(txp),
+      m_totalTime(totalTime),
+      m_traceFile(traceFile),
+      m_traceStreams(traceStreams)
+{
+}
+
+void
+RoutingExperiment::WriteBucket(Time now, uint64_t bytes, uint64_t packets)
+{
+    double kbs = (bytes * 8.0) / 1000;
+    m_output << now.GetSeconds() << " " << kbs << " " << packets << " " << m_nSinks << " "
+             << m_protocol << " " << m_txp << "\n";
+}
+
+bool
+RoutingExperiment::Run(const std::string& fileName, const std::string& flowsFile)
+{
+    m_output.open(fileName);
+    if (!m_output)
+    {
+        return false;
+    }
+
+    std::string phyMode("DsssRate11Mbps");
+    Config::SetDefault("ns3::OnOffApplication::PacketSize", StringValue("64"));
+    Config::SetDefault("ns3::OnOffApplication::DataRate", StringValue("2048bps"));
+    Config::SetDefault("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue(phyMode));
+
+    NodeContainer adhocNodes;
+    adhocNodes.Create(m_nNodes);
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211b);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(phyMode),
+                                 "ControlMode",
+                                 StringValue(phyMode));
+
+    YansWifiChannelHelper wifiChannel;
+    wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    wifiChannel.AddPropagationLoss("ns3::FriisPropagationLossModel");
+    YansWifiPhyHelper wifiPhy;
+    wifiPhy.SetChannel(wifiChannel.Create());
+    wifiPhy.Set("TxPowerStart", DoubleValue(m_txp));
+    wifiPhy.Set("TxPowerEnd", DoubleValue(m_txp));
+
+    WifiMacHelper wifiMac;
+    wifiMac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer adhocDevices = wifi.Install(wifiPhy, wifiMac, adhocNodes);
+
+    // Mobility first, on fixed streams, so that the trajectories do not
+    // depend on how many random variables the routing protocol creates
+    int64_t streamIndex = 0;
+    if (m_traceFile.empty())
+    {
+        MobilityHelper mobilityAdhoc;
+        Ptr<PositionAllocator> taPositionAlloc = CreateWaypointAllocator();
+        streamIndex += taPositionAlloc->AssignStreams(streamIndex);
+
+        mobilityAdhoc.SetMobilityModel("ns3::RandomWaypointMobilityModel",
+                                       "Speed",
+                                       StringValue(g_speed),
+                                       "Pause",
+                                       StringValue(g_pause),
+                                       "PositionAllocator",
+                                       PointerValue(taPositionAlloc));
+        mobilityAdhoc.SetPositionAllocator(taPositionAlloc);
+        mobilityAdhoc.Install(adhocNodes);
+        streamIndex += mobilityAdhoc.AssignStreams(adhocNodes, streamIndex);
+    }
+    else
+    {
+        // The trajectories were drawn from the first streams of this run
+        streamIndex = m_traceStreams;
+        Ptr<const WaypointTrace> trace = Create<WaypointTrace>(m_traceFile);
+        NS_ABORT_MSG_IF(trace->GetNNodes() < m_nNodes,
+                        m_traceFile << " has " << trace->GetNNodes() << " trajectories, need "
+                                    << m_nNodes);
+        for (uint32_t i = 0; i < m_nNodes; i++)
+        {
+            Ptr<TraceMobilityModel> mobility = CreateObject<TraceMobilityModel>();
+            mobility->SetTrajectory(trace, i);
+            adhocNodes.Get(i)->AggregateObject(mobility);
+        }
+    }
+
+    Ptr<UniformRandomVariable> startTime = CreateObject<UniformRandomVariable>();
+    startTime->SetStream(streamIndex++);
+
+    InternetStackHelper internet;
+    DsrHelper dsr;
+    DsrMainHelper dsrMain;
+    if (m_protocol == "DSR")
+    {
+        internet.Install(adhocNodes);
+        dsrMain.Install(dsr, adhocNodes);
+    }
+    else
+    {
+        AodvHelper aodv;
+        OlsrHelper olsr;
+        DsdvHelper dsdv;
+        Ipv4ListRoutingHelper list;
+        if (m_protocol == "AODV")
+        {
+            list.Add(aodv, 100);
+        }
+        else if (m_protocol == "OLSR")
+        {
+            list.Add(olsr, 100);
+        }
+        else if (m_protocol == "DSDV")
+        {
+            list.Add(dsdv, 100);
+        }
+        else
+        {
+            NS_FATAL_ERROR("Unknown routing protocol " << m_protocol);
+        }
+        internet.SetRoutingHelper(list);
+        internet.Install(adhocNodes);
+    }
+
+    Ipv4AddressHelper addressAdhoc;
+    if (m_nNodes < 255)
+    {
+        addressAdhoc.SetBase("10.1.1.0", "255.255.255.0");
+    }
+    else
+    {
+        addressAdhoc.SetBase("10.1.0.0", "255.255.0.0");
+    }
+    Ipv4InterfaceContainer adhocInterfaces = addressAdhoc.Assign(adhocDevices);
+
+    uint16_t port = 9;
+    OnOffHelper onoff("ns3::UdpSocketFactory", Address());
+    onoff.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1.0]"));
+    onoff.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+    PacketSinkHelper sink("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), port));
+
+    Ptr<ThroughputCollector> collector = Create<ThroughputCollector>(flowsFile, Seconds(1.0));
+    collector->SetMetadata("protocol", m_protocol);
+    collector->SetMetadata("nodes", m_nNodes);
+    collector->SetMetadata("txPower", m_txp);
+    collector->SetBucketCallback(MakeCallback(&RoutingExperiment::WriteBucket, this));
+
+    for (uint32_t i = 0; i < m_nSinks; i++)
+    {
+        ApplicationContainer sinkApp = sink.Install(adhocNodes.Get(i));
+        collector->AddSink(sinkApp.Get(0));
+        sinkApp.Start(Seconds(0.0));
+
+        onoff.SetAttribute("Remote",
+                           AddressValue(InetSocketAddress(adhocInterfaces.GetAddress(i), port)));
+        ApplicationContainer sourceApp = onoff.Install(adhocNodes.Get(i + m_nSinks));
+        sourceApp.Start(Seconds(startTime->GetValue(100.0, 101.0)));
+        sourceApp.Stop(Seconds(m_totalTime));
+    }
+
+    if (!collector->Start())
+    {
+        return false;
+    }
+
+    Simulator::Stop(Seconds(m_totalTime));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    m_output.close();
+    return true;
+}
+
+/**
+ * Split a comma separated list.
+ *
+ * \param list The list.
+ * \return its items
+ */
+static std::vector<std::string>
+SplitList(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ','))
+    {
+        items.push_back(item);
+    }
+    return items;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string protocols = "AODV,OLSR,DSDV,DSR";
+    std::string nodes = "50";
+    uint32_t nSinks = 10;
+    uint32_t seeds = 1;
+    double txp = 7.5;
+    double totalTime = 200.0;
+    uint32_t workers = 0;
+    std::string results = "manet-results.txt";
+    std::string traceFile = "";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("protocols",
+                 "Comma separated routing protocols (AODV, OLSR, DSDV, DSR)",
+                 protocols);
+    cmd.AddValue("nodes", "Comma separated node counts", nodes);
+    cmd.AddValue("nSinks", "Number of sinks (and sources)", nSinks);
+    cmd.AddValue("seeds", "Runs per cell (RngRun, RngRun+1, ...)", seeds);
+    cmd.AddValue("txp", "Transmit power (dBm)", txp);
+    cmd.AddValue("totalTime", "Simulated time (seconds)", totalTime);
+    cmd.AddValue("workers", "Concurrent worker processes (0: all cores)", workers);
+    cmd.AddValue("results", "Merged results file", results);
+    cmd.AddValue("traceFile",
+                 "Precompute trajectories into this waypoint trace (empty: RandomWaypoint per run)",
+                 traceFile);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::string> protocolList = SplitList(protocols);
+    std::vector<uint32_t> nodeList;
+    for (const auto& n : SplitList(nodes))
+    {
+        nodeList.push_back(std::stoul(n));
+        NS_ABORT_MSG_IF(nodeList.back() < 2 * nSinks,
+                        "Need at least " << 2 * nSinks << " nodes for " << nSinks << " sinks");
+    }
+    NS_ABORT_MSG_IF(seeds == 0, "seeds must be at least 1");
+
+    // Job k is protocol p, node count n, seed s with k = (p * |nodes| + n) * seeds + s
+    uint32_t nJobs = protocolList.size() * nodeList.size() * seeds;
+    bool singleCell = nodeList.size() == 1 && seeds == 1;
+    uint64_t baseRun = RngSeedManager::GetRun();
+    auto runName = [&](uint32_t k) {
+        uint32_t p = k / (nodeList.size() * seeds);
+        uint32_t n = (k / seeds) % nodeList.size();
+        uint32_t s = k % seeds;
+        if (singleCell)
+        {
+            return protocolList[p];
+        }
+        std::ostringstream name;
+        name << protocolList[p] << "-n" << nodeList[n] << "-s" << baseRun + s;
+        return name.str();
+    };
+    auto runFile = [&](uint32_t k) { return runName(k) + ".csv"; };
+
+    auto cellTrace = [&](uint32_t n, uint32_t s) {
+        if (traceFile.empty() || singleCell)
+        {
+            return traceFile;
+        }
+        std::ostringstream name;
+        name << traceFile << "-n" << nodeList[n] << "-s" << baseRun + s;
+        return name.str();
+    };
+
+    int64_t traceStreams = 0;
+    if (!traceFile.empty())
+    {
+        for (uint32_t n = 0; n < nodeList.size(); n++)
+        {
+            for (uint32_t s = 0; s < seeds; s++)
+            {
+                RngSeedManager::SetRun(baseRun + s);
+                Ptr<PositionAllocator> positions = CreateWaypointAllocator();
+                int64_t stream = positions->AssignStreams(0);
+                Ptr<RandomVariableStream> speed = CreateVariable(g_speed, stream++);
+                Ptr<RandomVariableStream> pause = CreateVariable(g_pause, stream++);
+                CompileWaypointTrace(cellTrace(n, s),
+                                     nodeList[n],
+                                     totalTime,
+                                     positions,
+                                     speed,
+                                     pause);
+                traceStreams = stream;
+            }
+        }
+    }
+
+    uint32_t failed = RunInWorkers(nJobs, workers, [&](uint32_t k) {
+        uint32_t p = k / (nodeList.size() * seeds);
+        uint32_t n = (k / seeds) % nodeList.size();
+        uint32_t s = k % seeds;
+        RngSeedManager::SetRun(baseRun + s);
+        RoutingExperiment experiment(protocolList[p],
+                                     nodeList[n],
+                                     nSinks,
+                                     txp,
+                                     totalTime,
+                                     cellTrace(n, s),
+                                     traceStreams);
+        return experiment.Run(runFile(k), runName(k) + ".flows") ? 0 : 1;
+    });
+    NS_ABORT_MSG_IF(failed != 0, failed << " of " << nJobs << " runs failed");
+
+    std::ofstream merged(results);
+    NS_ABORT_MSG_IF(!merged, "Cannot write " << results);
+    merged << "# manet-routing-compare nSinks=" << nSinks << " txp=" << txp
+           << " totalTime=" << totalTime << "\n"
+           << "# protocol:string nodes:uint32 seed:uint64 time:double(s) rate:double(kbps) "
+              "packets:uint32 sinks:uint32 txPower:double(dBm)\n";
+    for (uint32_t k = 0; k < nJobs; k++)
+    {
+        uint32_t p = k / (nodeList.size() * seeds);
+        uint32_t n = (k / seeds) % nodeList.size();
+        uint32_t s = k % seeds;
+        std::ifstream in(runFile(k));
+        double time;
+        double rate;
+        uint32_t packets;
+        uint32_t sinks;
+        std::string protocol;
+        double power;
+        while (in >> time >> rate >> packets >> sinks >> protocol >> power)
+        {
+            merged << protocol << " " << nodeList[n] << " " << baseRun + s << " " << time << " "
+                   << rate << " " << packets << " " << sinks << " " << power << "\n";
+        }
+        NS_ABORT_MSG_IF(!in.eof() || protocol != protocolList[p],
+                        "Malformed run output " << runFile(k));
+    }
+
+    return 0;
+}
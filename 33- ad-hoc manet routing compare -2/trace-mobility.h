@@ -0,0 +1,311 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TRACE_MOBILITY_H
+#define TRACE_MOBILITY_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Binary waypoint trace
+ *
+ * File layout (host byte order):
+ * - header: 8-byte magic "NS3WPTR1", uint32 version, uint32 nNodes;
+ * - uint64 offsets[nNodes + 1]: node i owns records offsets[i] to offsets[i + 1] - 1;
+ * - records: {double time, x, y, z}, sorted by time within each node.
+ *
+ * Between two records a node moves in a straight line at constant speed.
+ */
+struct TraceWaypoint
+{
+    double time; //!< seconds
+    double x;    //!< meters
+    double y;    //!< meters
+    double z;    //!< meters
+};
+
+/// Trace file header.
+struct TraceHeader
+{
+    char magic[8];    //!< "NS3WPTR1"
+    uint32_t version; //!< format version, 1
+    uint32_t nNodes;  //!< number of node trajectories
+};
+
+/**
+ * Generate random waypoint trajectories once and write them as a trace.
+ *
+ * Each node starts at a position drawn from \p positions. It then moves
+ * to the next drawn position at a drawn speed, pauses for a drawn time,
+ * and repeats until \p totalTime. This is the movement of
+ * RandomWaypointMobilityModel, evaluated ahead of time.
+ *
+ * \param fileName Output file.
+ * \param nNodes Number of trajectories.
+ * \param totalTime Trajectory length (seconds).
+ * \param positions Start positions and waypoints.
+ * \param speed Speed (m/s) of each leg.
+ * \param pause Pause (s) at each waypoint.
+ */
+inline void
+CompileWaypointTrace(const std::string& fileName,
+                     uint32_t nNodes,
+                     double totalTime,
+                     Ptr<PositionAllocator> positions,
+                     Ptr<RandomVariableStream> speed,
+                     Ptr<RandomVariableStream> pause)
+{
+    std::vector<uint64_t> offsets{0};
+    std::vector<TraceWaypoint> records;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        Vector current = positions->GetNext();
+        double t = 0;
+        records.push_back({t, current.x, current.y, current.z});
+        while (t < totalTime)
+        {
+            Vector next = positions->GetNext();
+            double legSpeed = speed->GetValue();
+            if (legSpeed <= 0)
+            {
+                // A node that draws zero speed never leaves its position
+                break;
+            }
+            t += CalculateDistance(current, next) / legSpeed;
+            records.push_back({t, next.x, next.y, next.z});
+            double legPause = pause->GetValue();
+            if (legPause > 0)
+            {
+                t += legPause;
+                records.push_back({t, next.x, next.y, next.z});
+            }
+            current = next;
+        }
+        offsets.push_back(records.size());
+    }
+
+    TraceHeader header;
+    std::memcpy(header.magic, "NS3WPTR1", sizeof(header.magic));
+    header.version = 1;
+    header.nNodes = nNodes;
+
+    std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_IF(!out, "Cannot write mobility trace " << fileName);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              records.size() * sizeof(TraceWaypoint));
+    NS_ABORT_MSG_IF(!out, "Cannot write mobility trace " << fileName);
+}
+
+/**
+ * Read-only memory mapping of a waypoint trace.
+ *
+ * Processes that map the same file share its pages, so parallel runs
+ * over one trace hold a single copy in memory.
+ */
+class WaypointTrace : public SimpleRefCount<WaypointTrace>
+{
+  public:
+    /**
+     * Map a trace file; aborts if it is missing or malformed.
+     *
+     * \param fileName Trace file written by CompileWaypointTrace.
+     */
+    explicit WaypointTrace(const std::string& fileName)
+    {
+        int fd = open(fileName.c_str(), O_RDONLY);
+        NS_ABORT_MSG_IF(fd < 0, "Cannot open mobility trace " << fileName);
+        struct stat st;
+        NS_ABORT_MSG_IF(fstat(fd, &st) < 0, "Cannot stat mobility trace " << fileName);
+        m_size = st.st_size;
+        NS_ABORT_MSG_IF(m_size < sizeof(TraceHeader), "Truncated mobility trace " << fileName);
+        m_base = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        NS_ABORT_MSG_IF(m_base == MAP_FAILED, "Cannot map mobility trace " << fileName);
+
+        const auto* header = static_cast<const TraceHeader*>(m_base);
+        NS_ABORT_MSG_IF(std::memcmp(header->magic, "NS3WPTR1", sizeof(header->magic)) != 0 ||
+                            header->version != 1,
+                        "Not a mobility trace: " << fileName);
+        m_nNodes = header->nNodes;
+        m_offsets = reinterpret_cast<const uint64_t*>(header + 1);
+        m_records = reinterpret_cast<const TraceWaypoint*>(m_offsets + m_nNodes + 1);
+        std::size_t tableEnd = sizeof(TraceHeader) + (m_nNodes + 1) * sizeof(uint64_t);
+        NS_ABORT_MSG_IF(m_size < tableEnd ||
+                            m_size != tableEnd + m_offsets[m_nNodes] * sizeof(TraceWaypoint),
+                        "Truncated mobility trace " << fileName);
+    }
+
+    ~WaypointTrace()
+    {
+        munmap(m_base, m_size);
+    }
+
+    WaypointTrace(const WaypointTrace&) = delete;
+    WaypointTrace& operator=(const WaypointTrace&) = delete;
+
+    /// \return the number of trajectories
+    uint32_t GetNNodes() const
+    {
+        return m_nNodes;
+    }
+
+    /**
+     * \param node Trajectory index.
+     * \return the first waypoint of the trajectory
+     */
+    const TraceWaypoint* Begin(uint32_t node) const
+    {
+        NS_ASSERT(node < m_nNodes);
+        return m_records + m_offsets[node];
+    }
+
+    /**
+     * \param node Trajectory index.
+     * \return one past the last waypoint of the trajectory
+     */
+    const TraceWaypoint* End(uint32_t node) const
+    {
+        NS_ASSERT(node < m_nNodes);
+        return m_records + m_offsets[node + 1];
+    }
+
+  private:
+    void* m_base;                   //!< mapping start
+    std::size_t m_size;             //!< mapping length
+    uint32_t m_nNodes;              //!< number of trajectories
+    const uint64_t* m_offsets;      //!< per-node record offsets
+    const TraceWaypoint* m_records; //!< waypoint records
+};
+
+/**
+ * \ingroup mobility
+ * \brief Mobility model that plays back one trajectory of a WaypointTrace
+ *
+ * Positions are evaluated on demand: a binary search on time finds the
+ * current leg, and the position is interpolated along it. No events are
+ * scheduled, so a node costs nothing while nobody asks where it is, and
+ * no course change notifications are fired.
+ */
+class TraceMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::TraceMobilityModel")
+                                .SetParent<MobilityModel>()
+                                .SetGroupName("Mobility")
+                                .AddConstructor<TraceMobilityModel>();
+        return tid;
+    }
+
+    TraceMobilityModel()
+        : m_begin(nullptr),
+          m_end(nullptr),
+          m_leg(0)
+    {
+    }
+
+    /**
+     * \param trace The mapped trace; kept alive by this model.
+     * \param node Trajectory index to play back.
+     */
+    void SetTrajectory(Ptr<const WaypointTrace> trace, uint32_t node)
+    {
+        NS_ABORT_MSG_IF(node >= trace->GetNNodes(),
+                        "Trajectory " << node << " not in a trace of " << trace->GetNNodes());
+        m_trace = trace;
+        m_begin = trace->Begin(node);
+        m_end = trace->End(node);
+        m_leg = 0;
+    }
+
+  private:
+    /**
+     * \param t Time (seconds).
+     * \return index of the last waypoint at or before \p t (0 before the first)
+     */
+    std::size_t FindLeg(double t) const
+    {
+        std::size_t n = m_end - m_begin;
+        // Simulation time only moves forward, so the last leg usually still holds
+        if (m_leg < n && m_begin[m_leg].time <= t &&
+            (m_leg + 1 == n || t < m_begin[m_leg + 1].time))
+        {
+            return m_leg;
+        }
+        const TraceWaypoint* it =
+            std::upper_bound(m_begin, m_end, t, [](double time, const TraceWaypoint& w) {
+                return time < w.time;
+            });
+        m_leg = it == m_begin ? 0 : (it - m_begin) - 1;
+        return m_leg;
+    }
+
+    Vector DoGetPosition() const override
+    {
+        NS_ASSERT_MSG(m_begin != m_end, "TraceMobilityModel has no trajectory");
+        double t = Simulator::Now().GetSeconds();
+        std::size_t i = FindLeg(t);
+        const TraceWaypoint& a = m_begin[i];
+        if (i + 1 == static_cast<std::size_t>(m_end - m_begin) || t <= a.time)
+        {
+            return Vector(a.x, a.y, a.z);
+        }
+        const TraceWaypoint& b = m_begin[i + 1];
+        double f = (t - a.time) / (b.time - a.time);
+        return Vector(a.x + f * (b.x - a.x), a.y + f * (b.y - a.y), a.z + f * (b.z - a.z));
+    }
+
+    void DoSetPosition(const Vector& position) override
+    {
+        NS_FATAL_ERROR("TraceMobilityModel positions come from the trace");
+    }
+
+    Vector DoGetVelocity() const override
+    {
+        NS_ASSERT_MSG(m_begin != m_end, "TraceMobilityModel has no trajectory");
+        double t = Simulator::Now().GetSeconds();
+        std::size_t i = FindLeg(t);
+        if (i + 1 == static_cast<std::size_t>(m_end - m_begin) || t < m_begin[i].time)
+        {
+            return Vector(0, 0, 0);
+        }
+        const TraceWaypoint& a = m_begin[i];
+        const TraceWaypoint& b = m_begin[i + 1];
+        double dt = b.time - a.time;
+        return Vector((b.x - a.x) / dt, (b.y - a.y) / dt, (b.z - a.z) / dt);
+    }
+
+    Ptr<const WaypointTrace> m_trace; //!< keeps the mapping alive
+    const TraceWaypoint* m_begin;     //!< first waypoint of the trajectory
+    const TraceWaypoint* m_end;       //!< one past the last waypoint
+    mutable std::size_t m_leg;        //!< leg found by the previous lookup
+};
+
+NS_OBJECT_ENSURE_REGISTERED(TraceMobilityModel);
+
+} // namespace ns3
+
+#endif /* TRACE_MOBILITY_H */
@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BDP_BUFFERS_H
+#define BDP_BUFFERS_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace ns3
+{
+
+/**
+ * TCP socket buffer size for a path: twice its bandwidth-delay product, so
+ * the window can fill a long, fast link, and never below the 128 KiB
+ * TcpSocket default.
+ *
+ * SndBufSize and RcvBufSize are 32-bit attributes. A larger result is
+ * clamped to 4 GiB - 1 with a warning on stderr instead of wrapping.
+ *
+ * \param rate Bottleneck data rate.
+ * \param rtt Round trip time of the path.
+ * \return the buffer size in bytes
+ */
+inline uint32_t
+BdpBufferSize(DataRate rate, Time rtt)
+{
+    uint64_t bdpBytes = rate.GetBitRate() / 8 * rtt.GetSeconds();
+    uint64_t wanted = std::max<uint64_t>(2 * bdpBytes, 131072);
+    if (wanted > std::numeric_limits<uint32_t>::max())
+    {
+        std::cerr << "Warning: 2 x BDP (" << wanted
+                  << " bytes) exceeds the 32-bit socket buffer limit; clamped" << std::endl;
+        wanted = std::numeric_limits<uint32_t>::max();
+    }
+    return static_cast<uint32_t>(wanted);
+}
+
+} // namespace ns3
+
+#endif /* BDP_BUFFERS_H */
@@ -0,0 +1,194 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ * \brief Pairwise path-loss cache in front of another loss model
+ *
+ * Keeps the inner model's result for every (transmitter, receiver)
+ * mobility pair, along with both positions at the time it was computed.
+ * On later frames the cached result is reused as long as neither node has
+ * moved and the transmit power is the same, so static APs and slow walkers
+ * stop paying for a log10 per frame. With Quantum > 0, positions are
+ * compared after snapping them to a grid of that size. Small movements
+ * then also hit the cache, at the cost of exactness.
+ *
+ * With Quantum = 0 a hit needs identical positions and transmit power, so
+ * results match the uncached model bit for bit. A different transmit power
+ * is a miss that replaces the entry. The inner model must be
+ * deterministic: path-loss models such as LogDistance, Friis or
+ * ThreeLogDistance, not fading models.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::CachedPropagationLossModel")
+                .SetParent<PropagationLossModel>()
+                .SetGroupName("Propagation")
+                .AddConstructor<CachedPropagationLossModel>()
+                .AddAttribute("Inner",
+                              "The loss model whose results are cached.",
+                              PointerValue(),
+                              MakePointerAccessor(&CachedPropagationLossModel::m_inner),
+                              MakePointerChecker<PropagationLossModel>())
+                .AddAttribute("Enabled",
+                              "Use the cache; if false every call goes to the inner model.",
+                              BooleanValue(true),
+                              MakeBooleanAccessor(&CachedPropagationLossModel::m_enabled),
+                              MakeBooleanChecker())
+                .AddAttribute("Quantum",
+                              "Position grid (m) used to decide that a node has not moved; "
+                              "0 requires exact positions.",
+                              DoubleValue(0),
+                              MakeDoubleAccessor(&CachedPropagationLossModel::m_quantum),
+                              MakeDoubleChecker<double>(0));
+        return tid;
+    }
+
+    CachedPropagationLossModel()
+        : m_enabled(true),
+          m_quantum(0),
+          m_hits(0),
+          m_misses(0)
+    {
+    }
+
+    /**
+     * \param inner The loss model whose results are cached.
+     */
+    void SetInner(Ptr<PropagationLossModel> inner)
+    {
+        m_inner = inner;
+        m_cache.clear();
+    }
+
+    /// \return the number of lookups answered from the cache
+    uint64_t GetHits() const
+    {
+        return m_hits;
+    }
+
+    /// \return the number of lookups forwarded to the inner model
+    uint64_t GetMisses() const
+    {
+        return m_misses;
+    }
+
+    /// \return hits / (hits + misses), or 0 before the first lookup
+    double GetHitRate() const
+    {
+        uint64_t total = m_hits + m_misses;
+        return total == 0 ? 0.0 : static_cast<double>(m_hits) / total;
+    }
+
+  private:
+    /// Cached result of one ordered node pair.
+    struct Entry
+    {
+        Vector a;          //!< transmitter position (or grid cell) at computation time
+        Vector b;          //!< receiver position (or grid cell) at computation time
+        double txPowerDbm; //!< transmit power the entry was computed with
+        double rxPowerDbm; //!< inner model result for txPowerDbm
+    };
+
+    /// Hash of an ordered mobility model pair.
+    struct PairHash
+    {
+        /**
+         * \param key the pair
+         * \return its hash
+         */
+        std::size_t operator()(
+            const std::pair<const MobilityModel*, const MobilityModel*>& key) const
+        {
+            std::size_t h = std::hash<const void*>()(key.first);
+            return h ^ (std::hash<const void*>()(key.second) + 0x9e3779b97f4a7c15ULL + (h << 6) +
+                        (h >> 2));
+        }
+    };
+
+    /**
+     * \param position a position
+     * \return the position snapped to the Quantum grid, or unchanged if Quantum is 0
+     */
+    Vector Snap(const Vector& position) const
+    {
+        if (m_quantum <= 0)
+        {
+            return position;
+        }
+        return Vector(std::floor(position.x / m_quantum),
+                      std::floor(position.y / m_quantum),
+                      std::floor(position.z / m_quantum));
+    }
+
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override
+    {
+        NS_ASSERT_MSG(m_inner, "CachedPropagationLossModel needs an Inner model");
+        if (!m_enabled)
+        {
+            return m_inner->CalcRxPower(txPowerDbm, a, b);
+        }
+
+        Vector posA = Snap(a->GetPosition());
+        Vector posB = Snap(b->GetPosition());
+        auto [it, inserted] = m_cache.try_emplace({PeekPointer(a), PeekPointer(b)});
+        Entry& entry = it->second;
+        if (!inserted && entry.a == posA && entry.b == posB && entry.txPowerDbm == txPowerDbm)
+        {
+            m_hits++;
+            return entry.rxPowerDbm;
+        }
+
+        m_misses++;
+        double rxPowerDbm = m_inner->CalcRxPower(txPowerDbm, a, b);
+        entry = Entry{posA, posB, txPowerDbm, rxPowerDbm};
+        return rxPowerDbm;
+    }
+
+    int64_t DoAssignStreams(int64_t stream) override
+    {
+        return m_inner ? m_inner->AssignStreams(stream) : 0;
+    }
+
+    Ptr<PropagationLossModel> m_inner; //!< the cached model
+    bool m_enabled;                    //!< Enabled attribute
+    double m_quantum;                  //!< Quantum attribute
+    mutable std::unordered_map<std::pair<const MobilityModel*, const MobilityModel*>,
+                               Entry,
+                               PairHash>
+        m_cache;                       //!< per-pair cache
+    mutable uint64_t m_hits;           //!< cache hits
+    mutable uint64_t m_misses;         //!< cache misses
+};
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
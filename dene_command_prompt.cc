@@ -1,10 +1,15 @@
 #include "ns3/core-module.h"
 #include "ns3/mobility-module.h"
 
+#include "ladder-scheduler.h"
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("SimpleTrafficSimulation");
 
+// Araç başına tek bir periyodik rapor olayı; yeniden planlamada bellek ayrılmaz
+static std::vector<Ptr<EventImpl>> g_reportEvents;
+
 void ReportPosition(Ptr<Node> node)
 {
     Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
@@ -14,7 +19,7 @@ void ReportPosition(Ptr<Node> node)
               << " konumu: x=" << pos.x << " y=" << pos.y << std::endl;
 
     // Tekrar planla
-    Simulator::Schedule(Seconds(1.0), &ReportPosition, node);
+    Simulator::Schedule(Seconds(1.0), g_reportEvents[node->GetId()]);
 }
 
 int main(int argc, char *argv[])
@@ -22,13 +27,19 @@ int main(int argc, char *argv[])
     uint32_t numberOfVehicles = 3;
     double simulationTime = 10.0;
     double speed = 10.0; // m/s (36 km/h)
+    std::string scheduler = "ns3::MapScheduler";
 
     CommandLine cmd;
     cmd.AddValue("n", "Araç sayısı", numberOfVehicles);
     cmd.AddValue("t", "Simülasyon süresi (saniye)", simulationTime);
     cmd.AddValue("speed", "Araç hızı (m/s)", speed);
+    cmd.AddValue("scheduler", "Olay zamanlayıcı TypeId (ör. ns3::LadderScheduler)", scheduler);
     cmd.Parse(argc, argv);
 
+    ObjectFactory schedulerFactory;
+    schedulerFactory.SetTypeId(scheduler);
+    Simulator::SetScheduler(schedulerFactory);
+
     NodeContainer vehicles;
     vehicles.Create(numberOfVehicles);
 
@@ -36,16 +47,20 @@ int main(int argc, char *argv[])
     mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
     mobility.Install(vehicles);
 
+    g_reportEvents.resize(vehicles.GetN()); // Araçlar tek düğümler: ID = indeks
     for (uint32_t i = 0; i < numberOfVehicles; ++i)
     {
         Ptr<ConstantVelocityMobilityModel> mob = vehicles.Get(i)->GetObject<ConstantVelocityMobilityModel>();
         mob->SetPosition(Vector(0.0, i * 5.0, 0.0)); // Araçları y ekseninde 5 metre aralıklı yerleştir
         mob->SetVelocity(Vector(speed, 0.0, 0.0));   // Sabit hızla x yönünde hareket
-        Simulator::Schedule(Seconds(1.0), &ReportPosition, vehicles.Get(i)); // Her saniye konum raporu başlat
+        Ptr<EventImpl> report(MakeEvent(&ReportPosition, vehicles.Get(i)), false);
+        g_reportEvents[vehicles.Get(i)->GetId()] = report;
+        Simulator::Schedule(Seconds(1.0), report); // Her saniye konum raporu başlat
     }
 
     Simulator::Stop(Seconds(simulationTime));
     Simulator::Run();
+    g_reportEvents.clear();
     Simulator::Destroy();
 
     return 0;
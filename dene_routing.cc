@@ -32,16 +32,23 @@ NS_LOG_COMPONENT_DEFINE("StaticRoutingSlash32Test");
 int
 main(int argc, char* argv[])
 {
-    // Log seviyesini ayarla
-    LogComponentEnable("StaticRoutingSlash32Test", LOG_LEVEL_INFO);
-    LogComponentEnable("OnOffApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("PacketSink", LOG_LEVEL_INFO);
-    LogComponentEnable("Ipv4StaticRouting", LOG_LEVEL_INFO);
+    bool verbose = true;
 
     // Allow the user to override any of the defaults and the above
     CommandLine cmd(__FILE__);
+    cmd.AddValue("verbose", "Log every transmission, reception and route lookup", verbose);
     cmd.Parse(argc, argv);
 
+    // Log seviyesini ayarla; her paket için satır yazıldığından sessiz
+    // ölçümlerde verbose=false kullan
+    if (verbose)
+    {
+        LogComponentEnable("StaticRoutingSlash32Test", LOG_LEVEL_INFO);
+        LogComponentEnable("OnOffApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("PacketSink", LOG_LEVEL_INFO);
+        LogComponentEnable("Ipv4StaticRouting", LOG_LEVEL_INFO);
+    }
+
     Ptr<Node> nA = CreateObject<Node>();
     Ptr<Node> nB = CreateObject<Node>();
     Ptr<Node> nC = CreateObject<Node>();
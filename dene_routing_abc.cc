@@ -21,14 +21,20 @@
  
  int main(int argc, char* argv[])
  {
-     LogComponentEnable("StaticRoutingSlash32Test", LOG_LEVEL_INFO);
-     LogComponentEnable("OnOffApplication", LOG_LEVEL_INFO);
-     LogComponentEnable("PacketSink", LOG_LEVEL_INFO);
-     LogComponentEnable("Ipv4StaticRouting", LOG_LEVEL_INFO);
+     bool verbose = true;
  
      CommandLine cmd(__FILE__);
+     cmd.AddValue("verbose", "Log every transmission, reception and route lookup", verbose);
      cmd.Parse(argc, argv);
  
+     if (verbose)
+     {
+         LogComponentEnable("StaticRoutingSlash32Test", LOG_LEVEL_INFO);
+         LogComponentEnable("OnOffApplication", LOG_LEVEL_INFO);
+         LogComponentEnable("PacketSink", LOG_LEVEL_INFO);
+         LogComponentEnable("Ipv4StaticRouting", LOG_LEVEL_INFO);
+     }
+ 
      Ptr<Node> nA = CreateObject<Node>();
      Ptr<Node> nB = CreateObject<Node>();
      Ptr<Node> nC = CreateObject<Node>();
@@ -0,0 +1,344 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "ns3/core-module.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <cxxabi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Wall time and event counts per event handler type, shared by the
+ * ProfilingScheduler and the events it wraps.
+ */
+class EventProfileData : public SimpleRefCount<EventProfileData>
+{
+  public:
+    EventProfileData()
+        : m_startTicks(ReadTicks()),
+          m_startClock(std::chrono::steady_clock::now())
+    {
+    }
+
+    /// \return a cycle counter (rdtsc) or, where there is none, steady_clock ns
+    static uint64_t ReadTicks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+#endif
+    }
+
+    /**
+     * \param type Dynamic type of the executed EventImpl.
+     * \param ticks Ticks spent in it.
+     */
+    void Record(const std::type_info& type, uint64_t ticks)
+    {
+        Entry& entry = m_entries[std::type_index(type)];
+        entry.count++;
+        entry.ticks += ticks;
+    }
+
+    /**
+     * Write the profile.
+     *
+     * \p fileName gets one "simulator;<handler> <ns>" line per handler type
+     * (folded stacks, as read by flamegraph.pl and speedscope).
+     * \p fileName.txt gets a table of events, total and mean time.
+     *
+     * \param fileName Output file.
+     * \param sampleInterval Every how many events one was measured.
+     */
+    void Write(const std::string& fileName, uint32_t sampleInterval) const
+    {
+        double nsPerTick = NsPerTick();
+        std::vector<std::pair<std::string, Entry>> rows;
+        for (const auto& [type, entry] : m_entries)
+        {
+            rows.emplace_back(Demangle(type.name()), entry);
+        }
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+            return a.second.ticks > b.second.ticks;
+        });
+
+        std::ofstream folded(fileName);
+        std::ofstream table(fileName + ".txt");
+        NS_ABORT_MSG_IF(!folded || !table, "Cannot write event profile " << fileName);
+        table << "# events(est) total(ms,est) mean(ns) handler\n";
+        for (const auto& [name, entry] : rows)
+        {
+            double ns = entry.ticks * nsPerTick;
+            folded << "simulator;" << name << " "
+                   << static_cast<uint64_t>(ns * sampleInterval) << "\n";
+            table << entry.count * sampleInterval << " " << ns * sampleInterval / 1e6 << " "
+                  << ns / entry.count << " " << name << "\n";
+        }
+    }
+
+    /// \return true if nothing was recorded
+    bool IsEmpty() const
+    {
+        return m_entries.empty();
+    }
+
+  private:
+    /// Totals of one handler type.
+    struct Entry
+    {
+        uint64_t count = 0; //!< measured events
+        uint64_t ticks = 0; //!< ticks spent in them
+    };
+
+    /// \return nanoseconds per tick, calibrated over the profiler lifetime
+    double NsPerTick() const
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        uint64_t ticks = ReadTicks() - m_startTicks;
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() -
+                                                             m_startClock)
+                        .count();
+        return ticks == 0 ? 1.0 : ns / ticks;
+#else
+        return 1.0;
+#endif
+    }
+
+    /**
+     * \param mangled A type_info name.
+     * \return the demangled name, or \p mangled if it cannot be demangled
+     */
+    static std::string Demangle(const char* mangled)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+        std::string name = status == 0 && demangled ? demangled : mangled;
+        std::free(demangled);
+        // ';' separates frames in folded stacks
+        std::replace(name.begin(), name.end(), ';', ',');
+        return name;
+    }
+
+    std::unordered_map<std::type_index, Entry> m_entries; //!< totals per handler type
+    uint64_t m_startTicks;                                //!< ticks at construction
+    std::chrono::steady_clock::time_point m_startClock;   //!< clock at construction
+};
+
+/**
+ * EventImpl wrapper that times the event it owns.
+ */
+class ProfiledEvent : public EventImpl
+{
+  public:
+    /**
+     * \param inner The event; this wrapper takes over the caller's reference.
+     * \param data Where to record the measurement.
+     */
+    ProfiledEvent(EventImpl* inner, Ptr<EventProfileData> data)
+        : m_inner(inner),
+          m_data(data)
+    {
+    }
+
+    ~ProfiledEvent() override
+    {
+        if (m_inner)
+        {
+            m_inner->Unref();
+        }
+    }
+
+    /// Give the reference to the inner event back without dropping it.
+    void Release()
+    {
+        m_inner = nullptr;
+    }
+
+  private:
+    void Notify() override
+    {
+        if (m_inner->IsCancelled())
+        {
+            return;
+        }
+        uint64_t start = EventProfileData::ReadTicks();
+        m_inner->Invoke();
+        m_data->Record(typeid(*m_inner), EventProfileData::ReadTicks() - start);
+    }
+
+    EventImpl* m_inner;           //!< the timed event
+    Ptr<EventProfileData> m_data; //!< profile being filled
+};
+
+/**
+ * \ingroup scheduler
+ * \brief Scheduler that profiles event handlers on top of another scheduler
+ *
+ * Every SampleInterval-th inserted event is wrapped in a ProfiledEvent,
+ * which reads the cycle counter around the handler and adds the time to
+ * the handler's dynamic EventImpl type. The estimates are scaled by the
+ * sample interval.
+ *
+ * Attribution is by EventImpl type, not by function. A MakeEvent type names
+ * the object class and the signature of the scheduled function, not the
+ * function itself. All void() members of BsmApplication, for example, are
+ * reported as one line, as are all free functions with the same signature.
+ * To tell such handlers apart, give them distinct signatures or profile
+ * them separately.
+ *
+ * The report is written when the scheduler is destroyed, i.e. at
+ * Simulator::Destroy. An event that is not sampled costs a counter
+ * decrement on insertion and a type check when it is dequeued. It needs
+ * no allocation and no hash lookup; only cancelling an event (Remove)
+ * looks its uid up. Without this scheduler nothing is measured, so a
+ * script that does not select it pays nothing.
+ */
+class ProfilingScheduler : public Scheduler
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::ProfilingScheduler")
+                .SetParent<Scheduler>()
+                .SetGroupName("Core")
+                .AddConstructor<ProfilingScheduler>()
+                .AddAttribute("InnerScheduler",
+                              "TypeId of the scheduler that orders the events.",
+                              StringValue("ns3::MapScheduler"),
+                              MakeStringAccessor(&ProfilingScheduler::m_innerType),
+                              MakeStringChecker())
+                .AddAttribute("SampleInterval",
+                              "Measure one event out of this many.",
+                              UintegerValue(16),
+                              MakeUintegerAccessor(&ProfilingScheduler::m_sampleInterval),
+                              MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("ProfileFile",
+                              "Folded-stack output file; a table goes to <ProfileFile>.txt.",
+                              StringValue("simulator-profile.folded"),
+                              MakeStringAccessor(&ProfilingScheduler::m_fileName),
+                              MakeStringChecker());
+        return tid;
+    }
+
+    ProfilingScheduler()
+        : m_data(Create<EventProfileData>()),
+          m_sampleInterval(16),
+          m_countdown(0)
+    {
+    }
+
+    ~ProfilingScheduler() override
+    {
+        if (!m_data->IsEmpty())
+        {
+            m_data->Write(m_fileName, m_sampleInterval);
+        }
+    }
+
+    void Insert(const Event& ev) override
+    {
+        if (m_countdown > 0)
+        {
+            m_countdown--;
+            Inner()->Insert(ev);
+            return;
+        }
+        m_countdown = m_sampleInterval - 1;
+        auto wrapper = new ProfiledEvent(ev.impl, m_data);
+        m_wrapped[ev.key.m_uid] = wrapper;
+        Inner()->Insert(Event{wrapper, ev.key});
+    }
+
+    bool IsEmpty() const override
+    {
+        return Inner()->IsEmpty();
+    }
+
+    Event PeekNext() const override
+    {
+        return Inner()->PeekNext();
+    }
+
+    Event RemoveNext() override
+    {
+        Event ev = Inner()->RemoveNext();
+        // Only wrappers are in m_wrapped; the type check keeps the hash
+        // lookup off the path of unsampled events
+        if (typeid(*ev.impl) == typeid(ProfiledEvent))
+        {
+            m_wrapped.erase(ev.key.m_uid);
+        }
+        return ev;
+    }
+
+    void Remove(const Event& ev) override
+    {
+        auto it = m_wrapped.find(ev.key.m_uid);
+        if (it == m_wrapped.end())
+        {
+            Inner()->Remove(ev);
+            return;
+        }
+        ProfiledEvent* wrapper = it->second;
+        m_wrapped.erase(it);
+        Inner()->Remove(Event{wrapper, ev.key});
+        // The simulator drops its reference to ev.impl itself, so the
+        // wrapper must not drop it a second time
+        wrapper->Release();
+        wrapper->Unref();
+    }
+
+  private:
+    /// \return the wrapped scheduler, created on first use
+    Ptr<Scheduler> Inner() const
+    {
+        if (!m_inner)
+        {
+            ObjectFactory factory;
+            factory.SetTypeId(m_innerType);
+            m_inner = factory.Create<Scheduler>();
+        }
+        return m_inner;
+    }
+
+    mutable Ptr<Scheduler> m_inner;                         //!< wrapped scheduler
+    std::string m_innerType;                                //!< InnerScheduler attribute
+    Ptr<EventProfileData> m_data;                           //!< measurements
+    uint32_t m_sampleInterval;                              //!< SampleInterval attribute
+    uint32_t m_countdown;                                   //!< events left before the next sample
+    std::string m_fileName;                                 //!< ProfileFile attribute
+    std::unordered_map<uint32_t, ProfiledEvent*> m_wrapped; //!< pending wrappers by event uid
+};
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingScheduler);
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
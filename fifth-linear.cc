@@ -2,6 +2,8 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+ #include "bdp-buffers.h"
+ #include "geometric-rate-error-model.h"
  #include "tutorial-app.h"
  #include "ns3/applications-module.h"
  #include "ns3/core-module.h"
@@ -9,6 +11,7 @@
  #include "ns3/network-module.h"
  #include "ns3/point-to-point-module.h"
  #include <fstream>
+ #include <iostream>
  #include <vector>
  
  using namespace ns3;
@@ -27,11 +30,30 @@
      std::string congestionAlgorithm = "TcpCubic";
      uint32_t simulationTime = 20;
      int nodeCount = 3;
+     bool staticRouting = false;
+     std::string linkRate = "5Mbps";
+     std::string linkDelay = "2ms";
+     std::string appRate = "1Mbps";
+     uint32_t packetSize = 1040;
+     uint32_t packetCount = 1000;
+     bool tuneBuffers = false;
      
      CommandLine cmd(__FILE__);
      cmd.AddValue("mAlgo", "Congestion control algorithm", congestionAlgorithm);
      cmd.AddValue("mTime", "Simulation time (seconds)", simulationTime);
      cmd.AddValue("mNodes", "Number of nodes (minimum 2)", nodeCount);
+     cmd.AddValue("mStaticRouting",
+                  "Install per-node static routes instead of global routing (faster setup)",
+                  staticRouting);
+     cmd.AddValue("mRate", "Link data rate", linkRate);
+     cmd.AddValue("mDelay", "Link delay", linkDelay);
+     cmd.AddValue("mAppRate", "Application sending rate", appRate);
+     cmd.AddValue("mPacketSize", "Application packet size (bytes)", packetSize);
+     cmd.AddValue("mPackets", "Number of application packets", packetCount);
+     cmd.AddValue("mTuneBuffers",
+                  "Match the TCP segment size to mPacketSize (up to 1460 bytes) and size "
+                  "socket buffers to the BDP",
+                  tuneBuffers);
      cmd.Parse(argc, argv);
  
      // Minimum düğüm kontrolü
@@ -45,6 +67,30 @@
      Config::SetDefault("ns3::TcpSocket::InitialCwnd", UintegerValue(1));
      Config::SetDefault("ns3::TcpL4Protocol::RecoveryType",
                        TypeIdValue(TypeId::LookupByName("ns3::TcpClassicRecovery")));
+
+     if (tuneBuffers)
+     {
+         // Segment boyutu uygulama paketine eşitlenince TcpTxBuffer her yazmayı
+         // bölmeden tek segment olarak gönderir, TcpRxBuffer da birleştirme yapmaz.
+         // Segment en fazla 1460 bayt olabilir (P2P MTU 1500 - IP ve TCP başlıkları);
+         // daha büyük paketler yine bölünür.
+         // Tamponlar 2 x BDP: uzun, hızlı hatlarda pencere tampona takılmaz. Örnek:
+         // ./ns3 run "fifth-linear --mRate=10Gbps --mDelay=100ms --mAppRate=9Gbps
+         //            --mPacketSize=1460 --mPackets=1000000 --mTuneBuffers=1"
+         Time rtt = Time(linkDelay) * (2 * (nodeCount - 1));
+         uint32_t bufSize = BdpBufferSize(DataRate(linkRate), rtt);
+         const uint32_t maxSegmentSize = 1500 - 40;
+         uint32_t segmentSize = packetSize;
+         if (segmentSize > maxSegmentSize)
+         {
+             std::cerr << "Warning: mPacketSize (" << packetSize
+                       << " bytes) exceeds the 1460-byte MSS; segment size clamped" << std::endl;
+             segmentSize = maxSegmentSize;
+         }
+         Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(segmentSize));
+         Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(bufSize));
+         Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(bufSize));
+     }
  
      // Ağ Topolojisi Oluşturma
      NodeContainer allNodes;
@@ -60,11 +106,11 @@
  
      // Ağ Cihazları Konfigürasyonu
      PointToPointHelper p2p;
-     p2p.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
-     p2p.SetChannelAttribute("Delay", StringValue("2ms"));
+     p2p.SetDeviceAttribute("DataRate", StringValue(linkRate));
+     p2p.SetChannelAttribute("Delay", StringValue(linkDelay));
  
-     // Hata Modeli
-     Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+     // Hata Modeli: sonraki hataya kadarki mesafe tek seferde çekilir
+     Ptr<RateErrorModel> errorModel = CreateObject<GeometricRateErrorModel>();
      errorModel->SetAttribute("ErrorRate", DoubleValue(0.00001));
  
      std::vector<NetDeviceContainer> deviceGroups;
@@ -82,15 +128,13 @@
      // IP Adresleme
      Ipv4AddressHelper address;
      std::vector<Ipv4InterfaceContainer> interfaceGroups;
-     uint32_t baseNetwork = 1; // 10.1.x.0 networkleri için
-     
+     // Her bağlantıya bir /30: 10.0.0.0/8 içinde 2^22 bağlantıya kadar yeter
+     address.SetBase("10.0.0.0", "255.255.255.252");
+
      for(auto& devices : deviceGroups)
      {
-         std::ostringstream networkAddress;
-         networkAddress << "10.1." << baseNetwork << ".0";
-         address.SetBase(networkAddress.str().c_str(), "255.255.255.252");
          interfaceGroups.push_back(address.Assign(devices));
-         baseNetwork++;
+         address.NewNetwork();
      }
  
      // Uygulama Katmanı
@@ -108,13 +152,47 @@
      tcpSocket->TraceConnectWithoutContext("CongestionWindow", MakeCallback(&CwndChange));
  
      Ptr<TutorialApp> app = CreateObject<TutorialApp>();
-     app->Setup(tcpSocket, sinkAddress, 1040, 1000, DataRate("1Mbps"));
+     app->Setup(tcpSocket, sinkAddress, packetSize, packetCount, DataRate(appRate));
      allNodes.Get(0)->AddApplication(app);
      app->SetStartTime(Seconds(1.0));
      app->SetStopTime(Seconds(simulationTime));
  
      // Routing Tabloları
-     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+     if (staticRouting)
+     {
+         // Doğrusal topolojide yalnızca kaynak ve hedef alt ağlarına rota gerekir:
+         // veri sağ komşuya, ACK'ler sol komşuya iletilir. Düğüm başına O(1) rota,
+         // global routing'in tüm çizge üzerindeki SPF hesabını atlar.
+         Ipv4Mask linkMask("255.255.255.252");
+         Ipv4Address sourceNetwork = interfaceGroups.front().GetAddress(0).CombineMask(linkMask);
+         Ipv4Address sinkNetwork = interfaceGroups.back().GetAddress(1).CombineMask(linkMask);
+         Ipv4StaticRoutingHelper staticRoutingHelper;
+
+         for (int i = 0; i < nodeCount; i++)
+         {
+             Ptr<Ipv4> ipv4 = allNodes.Get(i)->GetObject<Ipv4>();
+             Ptr<Ipv4StaticRouting> routing = staticRoutingHelper.GetStaticRouting(ipv4);
+             if (i < nodeCount - 2)
+             {
+                 routing->AddNetworkRouteTo(sinkNetwork,
+                                            linkMask,
+                                            interfaceGroups[i].GetAddress(1),
+                                            ipv4->GetInterfaceForDevice(deviceGroups[i].Get(0)));
+             }
+             if (i > 1)
+             {
+                 Ptr<NetDevice> leftDevice = deviceGroups[i - 1].Get(1);
+                 routing->AddNetworkRouteTo(sourceNetwork,
+                                            linkMask,
+                                            interfaceGroups[i - 1].GetAddress(0),
+                                            ipv4->GetInterfaceForDevice(leftDevice));
+             }
+         }
+     }
+     else
+     {
+         Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+     }
  
      // Simülasyon
      Simulator::Stop(Seconds(simulationTime));
@@ -2,6 +2,7 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "geometric-rate-error-model.h"
 #include "tutorial-app.h"
 
 #include "ns3/applications-module.h"
@@ -104,7 +105,7 @@ main(int argc, char* argv[])
     NetDeviceContainer devices;
     devices = pointToPoint.Install(nodes);
 
-    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    Ptr<RateErrorModel> em = CreateObject<GeometricRateErrorModel>();
     em->SetAttribute("ErrorRate", DoubleValue(0.00001));
     devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
 
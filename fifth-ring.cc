@@ -2,6 +2,8 @@
  * SPDX-License-Identifier: GPL-2.0-only
  */
 
+#include "geometric-rate-error-model.h"
+#include "parallel-runs.h"
 #include "tutorial-app.h"
 
 #include "ns3/applications-module.h"
@@ -17,6 +19,8 @@
 #include "ns3/wifi-standards.h"
 
 #include <fstream>
+#include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -36,16 +40,113 @@ RxDrop(Ptr<const Packet> p)
     NS_LOG_UNCOND("RxDrop at " << Simulator::Now().GetSeconds());
 }
 
+/**
+ * Warm-start varyantı: ortak prefix'ten sonra child process'te uygulanan ayarlar.
+ */
+struct ForkVariant
+{
+    std::string algo;     //!< Congestion control algoritması ("ns3::" öneki olmadan)
+    double errorRate;     //!< Yeni ErrorRate; negatifse değiştirilmez
+    std::string dataRate; //!< Yeni link DataRate; boşsa değiştirilmez
+};
+
+/**
+ * "TcpNewReno,TcpBbr/0.0001,TcpVegas/0.00001/10Mbps" biçimindeki listeyi ayrıştırır.
+ *
+ * \param spec Virgülle ayrılmış algo[/errorRate[/dataRate]] listesi.
+ * \return Varyant listesi.
+ */
+static std::vector<ForkVariant>
+ParseVariants(const std::string& spec)
+{
+    std::vector<ForkVariant> variants;
+    std::istringstream list(spec);
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        if (item.empty())
+        {
+            continue;
+        }
+        std::istringstream fields(item);
+        ForkVariant v{"", -1.0, ""};
+        std::string errorRate;
+        std::getline(fields, v.algo, '/');
+        NS_ABORT_MSG_IF(v.algo.empty(), "mVariants: missing algorithm in \"" << item << "\"");
+        // Child'lar fork'tan sonra patlamasın: TypeId şimdi doğrulanır
+        TypeId tid;
+        NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe("ns3::" + v.algo, &tid) &&
+                                tid.IsChildOf(TcpCongestionOps::GetTypeId()),
+                            "mVariants: unknown congestion control algorithm \"" << v.algo
+                                                                                 << "\"");
+        if (std::getline(fields, errorRate, '/') && !errorRate.empty())
+        {
+            // Sayının tamamı okunmalı ve [0, 1] aralığında olmalı
+            std::istringstream number(errorRate);
+            char rest;
+            bool valid = (number >> v.errorRate) && !(number >> rest);
+            NS_ABORT_MSG_IF(!valid || v.errorRate < 0 || v.errorRate > 1,
+                            "mVariants: invalid error rate \"" << errorRate << "\" in \"" << item
+                                                                << "\"");
+        }
+        std::getline(fields, v.dataRate, '/');
+        variants.push_back(v);
+    }
+    return variants;
+}
+
+/**
+ * Varyant ayarlarını çalışan simülasyona uygular.
+ *
+ * \param v Uygulanacak varyant.
+ * \param socket Kaynak TCP soketi.
+ */
+static void
+ApplyVariant(const ForkVariant& v, Ptr<Socket> socket)
+{
+    ObjectFactory factory;
+    factory.SetTypeId("ns3::" + v.algo);
+    DynamicCast<TcpSocketBase>(socket)->SetCongestionControlAlgorithm(
+        factory.Create<TcpCongestionOps>());
+
+    if (v.errorRate >= 0)
+    {
+        Config::Set("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/ReceiveErrorModel/"
+                    "$ns3::RateErrorModel/ErrorRate",
+                    DoubleValue(v.errorRate));
+    }
+    if (!v.dataRate.empty())
+    {
+        Config::Set("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/DataRate",
+                    DataRateValue(DataRate(v.dataRate)));
+    }
+}
+
 int
 main(int argc, char* argv[])
 {
     std::string mAlgo = "TcpCubic";
     uint32_t mTime= 20;
+    double mForkAt = 5;
+    std::string mVariants;
+    uint32_t mWorkers = 0;
     CommandLine cmd(__FILE__);
     cmd.AddValue("mAlgo", "Congestion control algorithm", mAlgo);
     cmd.AddValue("mTime", "Simulation time", mTime);
+    cmd.AddValue("mForkAt", "Warm-up time shared by all variants (seconds)", mForkAt);
+    cmd.AddValue("mVariants",
+                 "Comma separated algo[/errorRate[/dataRate]] list; forks one child per "
+                 "variant at mForkAt",
+                 mVariants);
+    cmd.AddValue("mWorkers", "Concurrent variant processes (0: all cores)", mWorkers);
     cmd.Parse(argc, argv);
 
+    std::vector<ForkVariant> variants = ParseVariants(mVariants);
+    if (!variants.empty() && (mForkAt <= 0 || mForkAt >= mTime))
+    {
+        NS_FATAL_ERROR("mForkAt must be inside (0, mTime)");
+    }
+
     Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::"+mAlgo)); 
     Config::SetDefault("ns3::TcpSocket::InitialCwnd", UintegerValue(1));
     Config::SetDefault("ns3::TcpL4Protocol::RecoveryType",
@@ -69,7 +170,7 @@ main(int argc, char* argv[])
     devices23 = pointToPoint.Install(nodes23);
     devices30 = pointToPoint.Install(nodes30);
 
-    Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
+    Ptr<RateErrorModel> em = CreateObject<GeometricRateErrorModel>();
     em->SetAttribute("ErrorRate", DoubleValue(0.00001));
     devices01.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
     devices12.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
@@ -110,9 +211,38 @@ main(int argc, char* argv[])
 
     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
-    Simulator::Stop(Seconds(mTime));
+    if (variants.empty())
+    {
+        Simulator::Stop(Seconds(mTime));
+        Simulator::Run();
+        Simulator::Destroy();
+        return 0;
+    }
+
+    // Ortak prefix bir kez çalıştırılır, ardından her varyant copy-on-write
+    // bir child process'te mForkAt anından mTime'a kadar devam eder. Aynı anda
+    // en fazla mWorkers child çalışır.
+    Simulator::Stop(Seconds(mForkAt));
     Simulator::Run();
+
+    uint32_t failed = RunInWorkers(variants.size(), mWorkers, [&](uint32_t i) {
+        std::ofstream out("fifth-ring-" + std::to_string(i) + "-" + variants[i].algo + ".cwnd");
+        std::streambuf* log = std::clog.rdbuf(out.rdbuf());
+        ApplyVariant(variants[i], ns3TcpSocket);
+        Simulator::Stop(Seconds(mTime - mForkAt));
+        Simulator::Run();
+        Simulator::Destroy();
+        std::clog.rdbuf(log);
+        out.flush();
+        return out ? 0 : 1;
+    });
     Simulator::Destroy();
 
+    if (failed > 0)
+    {
+        std::cerr << failed << " variant(s) failed" << std::endl;
+        return 1;
+    }
+
     return 0;
 }
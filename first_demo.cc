@@ -9,6 +9,8 @@
 #include "ns3/point-to-point-module.h"
 #include "ns3/netanim-module.h" //NetAnim için gerekli header
 
+#include <memory>
+
 // Default Network Topology
 //
 //       10.1.1.0
@@ -23,12 +25,20 @@ NS_LOG_COMPONENT_DEFINE("FirstScriptExample");
 int
 main(int argc, char* argv[])
 {
+    bool tracing = true;
+    bool verbose = true;
+
     CommandLine cmd(__FILE__);
+    cmd.AddValue("tracing", "Enable NetAnim and pcap output", tracing);
+    cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
     cmd.Parse(argc, argv);
 
     Time::SetResolution(Time::NS);
-    LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    if (verbose)
+    {
+        LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    }
 
     NodeContainer nodes;
     nodes.Create(2);
@@ -63,8 +73,12 @@ main(int argc, char* argv[])
     clientApps.Start(Seconds(1.0));
     clientApps.Stop(Seconds(10.0));
 
-    AnimationInterface anim("first_demo.xml");
-    pointToPoint.EnablePcapAll("first");
+    std::unique_ptr<AnimationInterface> anim;
+    if (tracing)
+    {
+        anim = std::make_unique<AnimationInterface>("first_demo.xml");
+        pointToPoint.EnablePcapAll("first");
+    }
     
 
     Simulator::Run();
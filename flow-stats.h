@@ -0,0 +1,400 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLOW_STATS_H
+#define FLOW_STATS_H
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ * \brief Packet tag carrying the flow id and send time for FlowStats
+ *
+ * Serializes to 12 bytes and is found with one scan of the packet tag list.
+ */
+class FlowStatsTag : public Tag
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::FlowStatsTag")
+                                .SetParent<Tag>()
+                                .SetGroupName("Internet")
+                                .AddConstructor<FlowStatsTag>();
+        return tid;
+    }
+
+    FlowStatsTag()
+        : m_flowId(0),
+          m_txTime(0)
+    {
+    }
+
+    /**
+     * \param flowId Dense flow id.
+     * \param txTime Send time (ns).
+     */
+    FlowStatsTag(uint32_t flowId, int64_t txTime)
+        : m_flowId(flowId),
+          m_txTime(txTime)
+    {
+    }
+
+    TypeId GetInstanceTypeId() const override
+    {
+        return GetTypeId();
+    }
+
+    uint32_t GetSerializedSize() const override
+    {
+        return 12;
+    }
+
+    void Serialize(TagBuffer i) const override
+    {
+        i.WriteU32(m_flowId);
+        i.WriteU64(static_cast<uint64_t>(m_txTime));
+    }
+
+    void Deserialize(TagBuffer i) override
+    {
+        m_flowId = i.ReadU32();
+        m_txTime = static_cast<int64_t>(i.ReadU64());
+    }
+
+    void Print(std::ostream& os) const override
+    {
+        os << "flow=" << m_flowId << " txTime=" << m_txTime << "ns";
+    }
+
+    /// \return the dense flow id
+    uint32_t GetFlowId() const
+    {
+        return m_flowId;
+    }
+
+    /// \return the send time (ns)
+    int64_t GetTxTime() const
+    {
+        return m_txTime;
+    }
+
+  private:
+    uint32_t m_flowId; //!< dense flow id
+    int64_t m_txTime;  //!< send time (ns)
+};
+
+NS_OBJECT_ENSURE_REGISTERED(FlowStatsTag);
+
+/**
+ * Lightweight per-flow statistics for IPv4 unicast traffic.
+ *
+ * A flow is a (source, destination, protocol, source port, destination
+ * port) tuple. Each sent packet is hashed to a dense id. The id travels in
+ * a FlowStatsTag together with the send time, so the receiver reads the
+ * id from the tag and only compares it against the packet's tuple.
+ *
+ * Counters are kept as one array per statistic (structure of arrays),
+ * indexed by flow id. Delay goes into a log-scale histogram per flow:
+ * 8 sub-buckets per power of two, so percentiles are within about 12% of
+ * the exact value, at a fixed 2 KiB per flow. Jitter is the mean absolute
+ * difference between consecutive delays, as in FlowMonitor.
+ *
+ * Packets are counted where they enter and leave the IP layer
+ * (Ipv4L3Protocol SendOutgoing and LocalDeliver). Lost packets are the
+ * ones sent but not yet delivered when the report is written.
+ */
+class FlowStats : public SimpleRefCount<FlowStats>
+{
+  public:
+    /**
+     * Hook the IPv4 stack of the given nodes.
+     *
+     * \param nodes Nodes with an InternetStack installed.
+     */
+    void Install(NodeContainer nodes)
+    {
+        for (uint32_t i = 0; i < nodes.GetN(); i++)
+        {
+            Ptr<Ipv4L3Protocol> ipv4 = nodes.Get(i)->GetObject<Ipv4L3Protocol>();
+            NS_ABORT_MSG_UNLESS(ipv4, "FlowStats needs an InternetStack on node " << i);
+            ipv4->TraceConnectWithoutContext("SendOutgoing",
+                                             MakeCallback(&FlowStats::SendOutgoing, this));
+            ipv4->TraceConnectWithoutContext("LocalDeliver",
+                                             MakeCallback(&FlowStats::LocalDeliver, this));
+        }
+    }
+
+    /// \return the number of flows seen so far
+    uint32_t GetNFlows() const
+    {
+        return m_keys.size();
+    }
+
+    /**
+     * \param flowId Dense flow id.
+     * \param quantile Quantile in [0, 1].
+     * \return the delay quantile (upper edge of its histogram bucket)
+     */
+    Time GetDelayQuantile(uint32_t flowId, double quantile) const
+    {
+        uint64_t target = static_cast<uint64_t>(std::ceil(quantile * m_rxPackets[flowId]));
+        uint64_t seen = 0;
+        const uint32_t* hist = &m_delayHist[static_cast<std::size_t>(flowId) * kBuckets];
+        for (uint32_t b = 0; b < kBuckets; b++)
+        {
+            seen += hist[b];
+            if (seen >= target && seen > 0)
+            {
+                return NanoSeconds(BucketUpperEdge(b));
+            }
+        }
+        return Time(0);
+    }
+
+    /**
+     * Print one line per flow.
+     *
+     * \param os Output stream.
+     * \param duration Time the flows had to transmit, for the throughput column.
+     */
+    void Report(std::ostream& os, Time duration) const
+    {
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << "flow src -> dst proto txPkts rxPkts lost(%) thr(kbps) meanDelay(ms) "
+              "p50(ms) p99(ms) meanJitter(ms)\n";
+        for (uint32_t f = 0; f < m_keys.size(); f++)
+        {
+            const FlowKey& k = m_keys[f];
+            uint64_t rx = m_rxPackets[f];
+            uint64_t tx = m_txPackets[f];
+            double lost = tx == 0 ? 0 : 100.0 * (tx - std::min(tx, rx)) / tx;
+            os << f << " " << Ipv4Address(k.src) << ":" << k.srcPort << " -> "
+               << Ipv4Address(k.dst) << ":" << k.dstPort << " " << uint32_t(k.protocol) << " "
+               << tx << " " << rx << " " << std::fixed << std::setprecision(2) << lost << " "
+               << m_rxBytes[f] * 8.0 / 1000 / duration.GetSeconds() << " "
+               << (rx ? m_delaySum[f] / 1e6 / rx : 0) << " "
+               << GetDelayQuantile(f, 0.5).GetSeconds() * 1000 << " "
+               << GetDelayQuantile(f, 0.99).GetSeconds() * 1000 << " "
+               << (rx > 1 ? m_jitterSum[f] / 1e6 / (rx - 1) : 0) << "\n";
+        }
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+  private:
+    /// 5-tuple of a flow.
+    struct FlowKey
+    {
+        uint32_t src;     //!< source address
+        uint32_t dst;     //!< destination address
+        uint16_t srcPort; //!< source port (0 if not TCP/UDP)
+        uint16_t dstPort; //!< destination port (0 if not TCP/UDP)
+        uint8_t protocol; //!< IP protocol number
+
+        /**
+         * \param o Other key.
+         * \return true if both keys are equal
+         */
+        bool operator==(const FlowKey& o) const
+        {
+            return src == o.src && dst == o.dst && srcPort == o.srcPort &&
+                   dstPort == o.dstPort && protocol == o.protocol;
+        }
+    };
+
+    /// Hash of a FlowKey.
+    struct FlowKeyHash
+    {
+        /**
+         * \param k The key.
+         * \return its hash
+         */
+        std::size_t operator()(const FlowKey& k) const
+        {
+            uint64_t a = (uint64_t(k.src) << 32) | k.dst;
+            uint64_t b = (uint64_t(k.srcPort) << 24) | (uint64_t(k.dstPort) << 8) | k.protocol;
+            uint64_t h = (a ^ (b * 0xff51afd7ed558ccdULL)) * 0x9e3779b97f4a7c15ULL;
+            return h ^ (h >> 29);
+        }
+    };
+
+    static constexpr uint32_t kSubBits = 3;               //!< log2 of sub-buckets per octave
+    static constexpr uint32_t kBuckets = 64u << kSubBits; //!< histogram buckets per flow
+
+    /**
+     * \param ns Delay (ns), non-negative.
+     * \return its histogram bucket
+     */
+    static uint32_t BucketOf(uint64_t ns)
+    {
+        if (ns < (1u << kSubBits))
+        {
+            return ns;
+        }
+        uint32_t msb = 63 - __builtin_clzll(ns);
+        uint32_t sub = (ns >> (msb - kSubBits)) & ((1u << kSubBits) - 1);
+        return ((msb - kSubBits + 1) << kSubBits) | sub;
+    }
+
+    /**
+     * \param bucket Histogram bucket.
+     * \return the largest delay (ns) counted in it
+     */
+    static uint64_t BucketUpperEdge(uint32_t bucket)
+    {
+        if (bucket < (1u << kSubBits))
+        {
+            return bucket;
+        }
+        uint32_t msb = (bucket >> kSubBits) + kSubBits - 1;
+        uint64_t sub = bucket & ((1u << kSubBits) - 1);
+        uint64_t low = (uint64_t(1) << msb) | (sub << (msb - kSubBits));
+        return low + (uint64_t(1) << (msb - kSubBits)) - 1;
+    }
+
+    /**
+     * \param header IP header.
+     * \param packet IP payload, starting with the transport header.
+     * \return the flow key of the packet
+     */
+    static FlowKey KeyOf(const Ipv4Header& header, Ptr<const Packet> packet)
+    {
+        FlowKey key{header.GetSource().Get(),
+                    header.GetDestination().Get(),
+                    0,
+                    0,
+                    header.GetProtocol()};
+        if ((key.protocol == TcpL4Protocol::PROT_NUMBER ||
+             key.protocol == UdpL4Protocol::PROT_NUMBER) &&
+            packet->GetSize() >= 4)
+        {
+            // Both headers start with the source and destination ports
+            uint8_t ports[4];
+            packet->CopyData(ports, 4);
+            key.srcPort = (ports[0] << 8) | ports[1];
+            key.dstPort = (ports[2] << 8) | ports[3];
+        }
+        return key;
+    }
+
+    /**
+     * \param key Flow key.
+     * \return the dense id of the flow, allocated on first use
+     */
+    uint32_t FlowIdOf(const FlowKey& key)
+    {
+        auto [it, inserted] = m_ids.try_emplace(key, m_keys.size());
+        if (inserted)
+        {
+            m_keys.push_back(key);
+            m_txPackets.push_back(0);
+            m_txBytes.push_back(0);
+            m_rxPackets.push_back(0);
+            m_rxBytes.push_back(0);
+            m_delaySum.push_back(0);
+            m_jitterSum.push_back(0);
+            m_lastDelay.push_back(-1);
+            m_delayHist.resize(m_delayHist.size() + kBuckets, 0);
+        }
+        return it->second;
+    }
+
+    /**
+     * SendOutgoing trace sink: a locally originated packet leaves IP.
+     *
+     * \param header IP header.
+     * \param packet IP payload.
+     * \param interface Output interface.
+     */
+    void SendOutgoing(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface)
+    {
+        Ipv4Address dst = header.GetDestination();
+        if (dst.IsBroadcast() || dst.IsMulticast())
+        {
+            return;
+        }
+        uint32_t flowId = FlowIdOf(KeyOf(header, packet));
+        m_txPackets[flowId]++;
+        m_txBytes[flowId] += packet->GetSize();
+        FlowStatsTag tag;
+        if (!packet->PeekPacketTag(tag))
+        {
+            // A packet sent again with its old tag (e.g. echoed) keeps it;
+            // LocalDeliver then sees a tuple mismatch and skips the delay
+            packet->AddPacketTag(FlowStatsTag(flowId, Simulator::Now().GetNanoSeconds()));
+        }
+    }
+
+    /**
+     * LocalDeliver trace sink: a packet reaches its destination's IP layer.
+     *
+     * \param header IP header.
+     * \param packet IP payload.
+     * \param interface Input interface.
+     */
+    void LocalDeliver(const Ipv4Header& header, Ptr<const Packet> packet, uint32_t interface)
+    {
+        FlowStatsTag tag;
+        if (!packet->PeekPacketTag(tag))
+        {
+            return;
+        }
+        uint32_t f = tag.GetFlowId();
+        FlowKey key = KeyOf(header, packet);
+        if (f >= m_keys.size() || !(m_keys[f] == key))
+        {
+            auto it = m_ids.find(key);
+            if (it != m_ids.end())
+            {
+                m_rxPackets[it->second]++;
+                m_rxBytes[it->second] += packet->GetSize();
+            }
+            return;
+        }
+        int64_t delay = std::max<int64_t>(0, Simulator::Now().GetNanoSeconds() - tag.GetTxTime());
+        m_rxPackets[f]++;
+        m_rxBytes[f] += packet->GetSize();
+        m_delaySum[f] += delay;
+        if (m_lastDelay[f] >= 0)
+        {
+            m_jitterSum[f] += std::abs(delay - m_lastDelay[f]);
+        }
+        m_lastDelay[f] = delay;
+        m_delayHist[static_cast<std::size_t>(f) * kBuckets + BucketOf(delay)]++;
+    }
+
+    std::unordered_map<FlowKey, uint32_t, FlowKeyHash> m_ids; //!< 5-tuple to dense id
+    std::vector<FlowKey> m_keys;                              //!< dense id to 5-tuple
+    std::vector<uint64_t> m_txPackets;                        //!< packets sent per flow
+    std::vector<uint64_t> m_txBytes;                          //!< bytes sent per flow
+    std::vector<uint64_t> m_rxPackets;                        //!< packets delivered per flow
+    std::vector<uint64_t> m_rxBytes;                          //!< bytes delivered per flow
+    std::vector<int64_t> m_delaySum;                          //!< delay sum (ns) per flow
+    std::vector<int64_t> m_jitterSum;                         //!< jitter sum (ns) per flow
+    std::vector<int64_t> m_lastDelay;                         //!< last delay (ns), -1 if none
+    std::vector<uint32_t> m_delayHist;                        //!< kBuckets counters per flow
+};
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_H */
@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FUSED_PROPAGATION_LOSS_MODEL_H
+#define FUSED_PROPAGATION_LOSS_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ * \brief LogDistance followed by Friis, evaluated in one call
+ *
+ * Computes the same result as a LogDistancePropagationLossModel whose next
+ * model is a FriisPropagationLossModel, which is what
+ * YansWifiChannelHelper::Default() plus AddPropagationLoss("Friis") builds.
+ * The arithmetic is the same, step by step, so results match the chain
+ * bit for bit. The node distance, a square root over two virtual position
+ * lookups, is computed once, and the chain costs one virtual call per
+ * receiver instead of two.
+ *
+ * Models added behind this one (e.g. a RangePropagationLossModel) are
+ * still applied through the usual SetNext chain.
+ */
+class LogDistanceFriisPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::LogDistanceFriisPropagationLossModel")
+                .SetParent<PropagationLossModel>()
+                .SetGroupName("Propagation")
+                .AddConstructor<LogDistanceFriisPropagationLossModel>()
+                .AddAttribute("Exponent",
+                              "LogDistance path loss exponent.",
+                              DoubleValue(3.0),
+                              MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::m_exponent),
+                              MakeDoubleChecker<double>())
+                .AddAttribute(
+                    "ReferenceDistance",
+                    "LogDistance reference distance (m).",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::m_referenceDistance),
+                    MakeDoubleChecker<double>())
+                .AddAttribute(
+                    "ReferenceLoss",
+                    "LogDistance loss (dB) at the reference distance.",
+                    DoubleValue(46.6777),
+                    MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::m_referenceLoss),
+                    MakeDoubleChecker<double>())
+                .AddAttribute(
+                    "Frequency",
+                    "Friis carrier frequency (Hz).",
+                    DoubleValue(5.15e9),
+                    MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::SetFrequency,
+                                       &LogDistanceFriisPropagationLossModel::GetFrequency),
+                    MakeDoubleChecker<double>())
+                .AddAttribute(
+                    "SystemLoss",
+                    "Friis system loss (linear).",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::m_systemLoss),
+                    MakeDoubleChecker<double>())
+                .AddAttribute("MinLoss",
+                              "Friis minimum loss (dB).",
+                              DoubleValue(0.0),
+                              MakeDoubleAccessor(&LogDistanceFriisPropagationLossModel::m_minLoss),
+                              MakeDoubleChecker<double>());
+        return tid;
+    }
+
+    LogDistanceFriisPropagationLossModel()
+        : m_exponent(3.0),
+          m_referenceDistance(1.0),
+          m_referenceLoss(46.6777),
+          m_frequency(0),
+          m_lambda(0),
+          m_systemLoss(1.0),
+          m_minLoss(0.0)
+    {
+    }
+
+    /**
+     * \param frequency Friis carrier frequency (Hz).
+     */
+    void SetFrequency(double frequency)
+    {
+        m_frequency = frequency;
+        static const double C = 299792458.0; // speed of light in vacuum
+        m_lambda = C / frequency;
+    }
+
+    /// \return the Friis carrier frequency (Hz)
+    double GetFrequency() const
+    {
+        return m_frequency;
+    }
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override
+    {
+        double distance = a->GetDistanceFrom(b);
+
+        // LogDistancePropagationLossModel::DoCalcRxPower
+        double rxPowerDbm;
+        if (distance <= m_referenceDistance)
+        {
+            rxPowerDbm = txPowerDbm - m_referenceLoss;
+        }
+        else
+        {
+            double pathLossDb = 10 * m_exponent * std::log10(distance / m_referenceDistance);
+            double rxc = -m_referenceLoss - pathLossDb;
+            rxPowerDbm = txPowerDbm + rxc;
+        }
+
+        // FriisPropagationLossModel::DoCalcRxPower on that result
+        if (distance <= 0)
+        {
+            return rxPowerDbm - m_minLoss;
+        }
+        double numerator = m_lambda * m_lambda;
+        double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
+        double lossDb = -10 * std::log10(numerator / denominator);
+        return rxPowerDbm - std::max(lossDb, m_minLoss);
+    }
+
+    int64_t DoAssignStreams(int64_t stream) override
+    {
+        return 0;
+    }
+
+    double m_exponent;          //!< Exponent attribute
+    double m_referenceDistance; //!< ReferenceDistance attribute
+    double m_referenceLoss;     //!< ReferenceLoss attribute
+    double m_frequency;         //!< Frequency attribute
+    double m_lambda;            //!< wavelength (m) for m_frequency
+    double m_systemLoss;        //!< SystemLoss attribute
+    double m_minLoss;           //!< MinLoss attribute
+};
+
+NS_OBJECT_ENSURE_REGISTERED(LogDistanceFriisPropagationLossModel);
+
+} // namespace ns3
+
+#endif /* FUSED_PROPAGATION_LOSS_MODEL_H */
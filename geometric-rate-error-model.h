@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef GEOMETRIC_RATE_ERROR_MODEL_H
+#define GEOMETRIC_RATE_ERROR_MODEL_H
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+/**
+ * \ingroup errormodel
+ * \brief RateErrorModel that draws the distance to the next error
+ *
+ * RateErrorModel draws one uniform variate per packet. At rates such as
+ * 1e-5 nearly all of those draws are wasted. This model instead draws
+ * the number of error-free units (bits, bytes or packets) before the next
+ * error from the geometric distribution, G = floor(ln U / ln(1 - p)), and
+ * counts received units down against it. A packet is corrupted when the
+ * gap ends inside it. The gap is memoryless, so a fresh gap is drawn
+ * after each corrupted packet. Per-packet corruption probability is
+ * 1 - (1 - p)^units, the same as RateErrorModel, but only one variate is
+ * drawn per error.
+ *
+ * ErrorRate and ErrorUnit are inherited from RateErrorModel, so existing
+ * Config paths through $ns3::RateErrorModel keep working.
+ */
+class GeometricRateErrorModel : public RateErrorModel
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("ns3::GeometricRateErrorModel")
+                                .SetParent<RateErrorModel>()
+                                .SetGroupName("Network")
+                                .AddConstructor<GeometricRateErrorModel>();
+        return tid;
+    }
+
+    GeometricRateErrorModel()
+        : m_uniform(CreateObject<UniformRandomVariable>()),
+          m_gapRate(-1),
+          m_remaining(0)
+    {
+    }
+
+    /**
+     * Assign a fixed random variable stream number to the gap generator.
+     *
+     * \param stream First stream index to use.
+     * \return The number of stream indices assigned by this model.
+     */
+    int64_t AssignStreams(int64_t stream)
+    {
+        m_uniform->SetStream(stream);
+        return 1;
+    }
+
+  private:
+    bool DoCorrupt(Ptr<Packet> p) override
+    {
+        double rate = GetRate();
+        if (rate != m_gapRate)
+        {
+            // First packet, or ErrorRate changed since the last gap was drawn
+            m_gapRate = rate;
+            m_remaining = DrawGap();
+        }
+
+        uint64_t units = 1;
+        if (GetUnit() == ERROR_UNIT_BYTE)
+        {
+            units = p->GetSize();
+        }
+        else if (GetUnit() == ERROR_UNIT_BIT)
+        {
+            units = 8 * static_cast<uint64_t>(p->GetSize());
+        }
+
+        if (m_remaining >= units)
+        {
+            m_remaining -= units;
+            return false;
+        }
+        m_remaining = DrawGap();
+        return true;
+    }
+
+    void DoReset() override
+    {
+        m_gapRate = -1;
+    }
+
+    /**
+     * \return the number of error-free units before the next error
+     */
+    uint64_t DrawGap()
+    {
+        if (m_gapRate <= 0)
+        {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        if (m_gapRate >= 1)
+        {
+            return 0;
+        }
+        // 1 - U lies in (0, 1], so the logarithm is finite
+        double gap = std::floor(std::log(1.0 - m_uniform->GetValue()) / std::log1p(-m_gapRate));
+        if (gap >= static_cast<double>(std::numeric_limits<uint64_t>::max()))
+        {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return static_cast<uint64_t>(gap);
+    }
+
+    Ptr<UniformRandomVariable> m_uniform; //!< gap generator
+    double m_gapRate;                     //!< ErrorRate the current gap was drawn with
+    uint64_t m_remaining;                 //!< error-free units left before the next error
+};
+
+NS_OBJECT_ENSURE_REGISTERED(GeometricRateErrorModel);
+
+} // namespace ns3
+
+#endif /* GEOMETRIC_RATE_ERROR_MODEL_H */
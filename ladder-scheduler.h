@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * Implements the ladder queue of Tang, Goh and Thng (ACM TOMACS 2005).
+ * Far-future events are appended unsorted to the Top list. When the
+ * near-future events run out, Top is spread over a rung of buckets sized
+ * to its population, dense buckets are recursively split into finer
+ * rungs, and only small buckets are sorted into the Bottom list that
+ * feeds RemoveNext. For strictly periodic traffic (beacons, position
+ * reports) every Insert lands in Top or a rung bucket in O(1), giving
+ * O(1) amortized Insert and RemoveNext.
+ *
+ * Select it with `--SchedulerType=ns3::LadderScheduler` or through
+ * Simulator::SetScheduler.
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     * Register this type.
+     * \return The object TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid =
+            TypeId("ns3::LadderScheduler")
+                .SetParent<Scheduler>()
+                .SetGroupName("Core")
+                .AddConstructor<LadderScheduler>()
+                .AddAttribute("BottomThreshold",
+                              "Largest bucket that is sorted directly into the Bottom list "
+                              "instead of being split into a new rung.",
+                              UintegerValue(50),
+                              MakeUintegerAccessor(&LadderScheduler::m_bottomThreshold),
+                              MakeUintegerChecker<uint32_t>(1))
+                .AddAttribute("MaxRungs",
+                              "Maximum number of rungs below the Top list.",
+                              UintegerValue(8),
+                              MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                              MakeUintegerChecker<uint32_t>(1));
+        return tid;
+    }
+
+    LadderScheduler()
+        : m_topMin(0),
+          m_topMax(0),
+          m_topStart(0),
+          m_count(0),
+          m_bottomThreshold(50),
+          m_maxRungs(8)
+    {
+    }
+
+    ~LadderScheduler() override = default;
+
+    void Insert(const Event& ev) override
+    {
+        uint64_t ts = ev.key.m_ts;
+        m_count++;
+        if (ts >= m_topStart)
+        {
+            if (m_top.empty() || ts < m_topMin)
+            {
+                m_topMin = ts;
+            }
+            if (m_top.empty() || ts > m_topMax)
+            {
+                m_topMax = ts;
+            }
+            m_top.push_back(ev);
+            return;
+        }
+        for (auto& rung : m_rungs)
+        {
+            if (ts >= rung.CurrentStart())
+            {
+                rung.buckets[rung.BucketOf(ts)].push_back(ev);
+                rung.count++;
+                return;
+            }
+        }
+        m_bottom.insert(std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, KeyLess), ev);
+    }
+
+    bool IsEmpty() const override
+    {
+        return m_count == 0;
+    }
+
+    Event PeekNext() const override
+    {
+        NS_ASSERT(!IsEmpty());
+        Refill();
+        return m_bottom.front();
+    }
+
+    Event RemoveNext() override
+    {
+        NS_ASSERT(!IsEmpty());
+        Refill();
+        Event ev = m_bottom.front();
+        m_bottom.pop_front();
+        m_count--;
+        return ev;
+    }
+
+    void Remove(const Event& ev) override
+    {
+        uint64_t ts = ev.key.m_ts;
+        m_count--;
+        if (ts >= m_topStart)
+        {
+            EraseByUid(m_top, ev.key.m_uid);
+            return;
+        }
+        for (auto& rung : m_rungs)
+        {
+            if (ts >= rung.CurrentStart())
+            {
+                EraseByUid(rung.buckets[rung.BucketOf(ts)], ev.key.m_uid);
+                rung.count--;
+                return;
+            }
+        }
+        auto it = std::lower_bound(m_bottom.begin(), m_bottom.end(), ev, KeyLess);
+        NS_ASSERT_MSG(it != m_bottom.end() && it->key.m_uid == ev.key.m_uid,
+                      "event " << ev.key.m_uid << " not found");
+        m_bottom.erase(it);
+    }
+
+  private:
+    /// One rung: equal-width buckets covering [start, start + width * buckets.size()).
+    struct Rung
+    {
+        uint64_t start;                          //!< timestamp of the first bucket
+        uint64_t width;                          //!< bucket width in timestamp units
+        std::size_t current;                     //!< first bucket not yet dequeued
+        std::size_t count;                       //!< events held by this rung
+        std::vector<std::vector<Event>> buckets; //!< the buckets
+
+        /// \return the start timestamp of the current bucket
+        uint64_t CurrentStart() const
+        {
+            return start + current * width;
+        }
+
+        /**
+         * \param ts a timestamp inside this rung
+         * \return the index of the bucket holding \p ts
+         */
+        std::size_t BucketOf(uint64_t ts) const
+        {
+            return (ts - start) / width;
+        }
+    };
+
+    /**
+     * Order events by (timestamp, uid).
+     * \param a first event
+     * \param b second event
+     * \return true if \p a runs before \p b
+     */
+    static bool KeyLess(const Event& a, const Event& b)
+    {
+        return a.key < b.key;
+    }
+
+    /**
+     * Remove the event with the given uid from an unsorted list.
+     * \param events the list to search
+     * \param uid the event uid
+     */
+    static void EraseByUid(std::vector<Event>& events, uint32_t uid)
+    {
+        auto it = std::find_if(events.begin(), events.end(), [uid](const Event& e) {
+            return e.key.m_uid == uid;
+        });
+        NS_ASSERT_MSG(it != events.end(), "event " << uid << " not found");
+        *it = events.back();
+        events.pop_back();
+    }
+
+    /// Move the whole Top list onto a fresh first rung.
+    void TransferTop() const
+    {
+        uint64_t span = m_topMax - m_topMin;
+        std::size_t nBuckets = std::min<uint64_t>(m_top.size(), span + 1);
+        Rung rung{m_topMin, span / nBuckets + 1, 0, m_top.size(), {}};
+        rung.buckets.resize(nBuckets);
+        for (const auto& ev : m_top)
+        {
+            rung.buckets[rung.BucketOf(ev.key.m_ts)].push_back(ev);
+        }
+        m_topStart = rung.start + nBuckets * rung.width;
+        m_top.clear();
+        m_rungs.push_back(std::move(rung));
+    }
+
+    /**
+     * Split a dense bucket into a finer rung covering the same interval.
+     * \param events the bucket content
+     * \param start the bucket start timestamp
+     * \param width the bucket width
+     */
+    void SpawnRung(std::vector<Event>& events, uint64_t start, uint64_t width) const
+    {
+        uint64_t childWidth = (width + events.size() - 1) / events.size();
+        Rung rung{start, childWidth, 0, events.size(), {}};
+        rung.buckets.resize((width + childWidth - 1) / childWidth);
+        for (const auto& ev : events)
+        {
+            rung.buckets[rung.BucketOf(ev.key.m_ts)].push_back(ev);
+        }
+        m_rungs.push_back(std::move(rung));
+    }
+
+    /// Make sure the Bottom list holds the earliest events.
+    void Refill() const
+    {
+        while (m_bottom.empty())
+        {
+            while (!m_rungs.empty() && m_rungs.back().count == 0)
+            {
+                m_rungs.pop_back();
+            }
+            if (m_rungs.empty())
+            {
+                TransferTop();
+                continue;
+            }
+            Rung& rung = m_rungs.back();
+            while (rung.buckets[rung.current].empty())
+            {
+                rung.current++;
+            }
+            std::vector<Event> bucket;
+            bucket.swap(rung.buckets[rung.current]);
+            uint64_t start = rung.CurrentStart();
+            uint64_t width = rung.width;
+            rung.current++;
+            rung.count -= bucket.size();
+
+            auto [lo, hi] = std::minmax_element(bucket.begin(), bucket.end(), KeyLess);
+            bool split = bucket.size() > m_bottomThreshold && width > 1 &&
+                         lo->key.m_ts != hi->key.m_ts && m_rungs.size() < m_maxRungs;
+            if (split)
+            {
+                SpawnRung(bucket, start, width);
+            }
+            else
+            {
+                std::sort(bucket.begin(), bucket.end(), KeyLess);
+                m_bottom.assign(bucket.begin(), bucket.end());
+            }
+        }
+    }
+
+    // Refill() runs from the const PeekNext(), hence the mutable queue state.
+    mutable std::vector<Event> m_top;  //!< unsorted far-future events
+    mutable uint64_t m_topMin;         //!< smallest timestamp in Top
+    mutable uint64_t m_topMax;         //!< largest timestamp in Top
+    mutable uint64_t m_topStart;       //!< events at or after this go to Top
+    mutable std::vector<Rung> m_rungs; //!< rungs, coarsest first
+    mutable std::deque<Event> m_bottom; //!< sorted near-future events
+    uint32_t m_count;                  //!< total number of events
+    uint32_t m_bottomThreshold;        //!< BottomThreshold attribute
+    uint32_t m_maxRungs;               //!< MaxRungs attribute
+};
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
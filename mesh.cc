@@ -8,6 +8,11 @@
 #include "ns3/netanim-module.h" //NetAnim için gerekli header
 #include "ns3/mobility-module.h" //Mobility için gerekli header
 
+#include "flow-stats.h"
+
+#include <iostream>
+#include <memory>
+
 
 
 using namespace ns3;
@@ -17,12 +22,22 @@ NS_LOG_COMPONENT_DEFINE("MeshScriptExample");
 int
 main(int argc, char* argv[])
 {
+    bool tracing = true;
+    bool flowStats = false;
+    bool verbose = true;
+
     CommandLine cmd(__FILE__);
+    cmd.AddValue("tracing", "Enable NetAnim and pcap output", tracing);
+    cmd.AddValue("flowStats", "Print per-flow loss, delay and jitter", flowStats);
+    cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
     cmd.Parse(argc, argv);
 
     Time::SetResolution(Time::NS);
-    LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    if (verbose)
+    {
+        LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    }
 
     //CREATING NODES AND GROUPING THEM ACCORDING TO THE RING TOPOLOGY
     NodeContainer nodes, node01, node12, node23, node30, node02, node13;
@@ -105,11 +120,26 @@ main(int argc, char* argv[])
 
     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
-    AnimationInterface anim("mesh.xml");
-    pointToPoint.EnablePcapAll("mesh");
+    Ptr<FlowStats> stats;
+    if (flowStats)
+    {
+        stats = Create<FlowStats>();
+        stats->Install(nodes);
+    }
+
+    std::unique_ptr<AnimationInterface> anim;
+    if (tracing)
+    {
+        anim = std::make_unique<AnimationInterface>("mesh.xml");
+        pointToPoint.EnablePcapAll("mesh");
+    }
     
 
     Simulator::Run();
+    if (stats)
+    {
+        stats->Report(std::cout, Simulator::Now());
+    }
     Simulator::Destroy();
     return 0;
 }
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PARALLEL_RUNS_H
+#define PARALLEL_RUNS_H
+
+#include "ns3/core-module.h"
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+namespace ns3
+{
+
+/**
+ * Run independent simulation jobs in forked worker processes.
+ *
+ * Every job runs in its own process with its own simulator, node list and
+ * RNG state. A job therefore produces the same output it would produce in a
+ * sequential run with the same seed and run number. The caller must not
+ * have built or run anything in the simulator before calling this, unless
+ * every job is meant to continue from that shared state (a warm start).
+ *
+ * \param nJobs Number of jobs.
+ * \param nWorkers Maximum number of concurrent workers; 0 uses all cores.
+ * \param job Job body, called with the job index in the child process. Its
+ *            return value is the worker's exit status.
+ * \return The number of jobs that failed.
+ */
+inline uint32_t
+RunInWorkers(uint32_t nJobs, uint32_t nWorkers, const std::function<int(uint32_t)>& job)
+{
+    if (nWorkers == 0)
+    {
+        nWorkers = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    uint32_t running = 0;
+    uint32_t failed = 0;
+    auto reap = [&running, &failed]() {
+        int status = 0;
+        NS_ABORT_MSG_IF(wait(&status) < 0, "wait() failed");
+        running--;
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        {
+            failed++;
+        }
+    };
+
+    for (uint32_t i = 0; i < nJobs; i++)
+    {
+        if (running == nWorkers)
+        {
+            reap();
+        }
+        std::cout.flush();
+        std::clog.flush();
+        pid_t pid = fork();
+        NS_ABORT_MSG_IF(pid < 0, "fork() failed for job " << i);
+        if (pid == 0)
+        {
+            int status = job(i);
+            std::cout.flush();
+            std::clog.flush();
+            _exit(status);
+        }
+        running++;
+    }
+    while (running > 0)
+    {
+        reap();
+    }
+    return failed;
+}
+
+} // namespace ns3
+
+#endif /* PARALLEL_RUNS_H */
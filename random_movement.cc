@@ -9,6 +9,8 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/wifi-standards.h"
 #include "ns3/netanim-module.h"
+
+#include "switched-lan.h"
  
 using namespace ns3;
  
@@ -17,12 +19,20 @@ NS_LOG_COMPONENT_DEFINE("CustomExample");
 int
 main(int argc, char* argv[])
 {
+bool switched = false;
+bool verbose = true;
+
 CommandLine cmd(__FILE__);
+cmd.AddValue("switched", "Connect the home LAN through a learning switch instead of a shared bus", switched);
+cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
 cmd.Parse(argc, argv);
  
 Time::SetResolution(Time::NS);
+if (verbose)
+{
 LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
 LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+}
  
 // step-1 = creating group of nodes....
 NodeContainer allNodes,wifiStaNodes_test_link_0, wifiApNodes_test_link_0;
@@ -40,8 +50,18 @@ homeLan.SetChannelAttribute("DataRate", StringValue("100Mbps"));
 homeLan.SetChannelAttribute("Delay", TimeValue(NanoSeconds(6560))); 
  
 // step-3 = creating devices
+// switched=true: every node gets its own link to a bridge node
 NetDeviceContainer csmaDevices;
+Ptr<Node> lanSwitch;
+if (switched)
+{
+lanSwitch = CreateObject<Node>();
+csmaDevices = InstallSwitchedLan(homeLan, allNodes, lanSwitch);
+}
+else
+{
 csmaDevices = homeLan.Install(allNodes);
+}
  
 MobilityHelper m;
 Ptr<ListPositionAllocator> p = CreateObject<ListPositionAllocator>();
@@ -67,6 +87,10 @@ m.Install(allNodes.Get(3));
 
 m.SetMobilityModel("ns3::ConstantPositionMobilityModel");
 m.Install(allNodes.Get(0));
+if (lanSwitch)
+{
+m.Install(lanSwitch);
+}
  
 // step-4 = Install ip stack
 InternetStackHelper stack;
@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "parallel-runs.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Remote station manager footprint benchmark
+//
+// One 802.11n AP serves nSta stations placed within 10 m, sending each of
+// them a 100-byte UDP datagram every 100 ms. The AP therefore keeps rate
+// control state for every station and updates it on every transmission.
+// Each manager runs in its own forked process, so peak RSS is not shared
+// between runs. The report gives, per manager:
+//
+//   updates      rate-control feedback reports made by the AP: acked data
+//                MPDUs (WifiMac AckedMpdu) plus failed data transmissions
+//                (MacTxDataFailed), i.e. ReportDataOk/ReportDataFailed calls
+//   updates/s    those reports per wall-clock second, whole simulation
+//                included; not the cost of the manager alone
+//   RSSgrow/STA  peak RSS growth during the run per station (association,
+//                queues and traffic as well as the manager's station state)
+//   events/s     simulator events per wall-clock second
+//
+// The manager implementations are ns-3's own; this measures them, it does
+// not shrink their per-station state.
+//
+// Note: an ns-3 AP hands out at most 2007 association IDs.
+//
+// ./ns3 run "rate-manager-benchmark --nSta=1000"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("RateManagerBenchmark");
+
+static uint64_t g_updates = 0; //!< rate-control reports made by the AP
+
+/**
+ * AckedMpdu trace sink; counts acknowledged data MPDUs.
+ *
+ * \param mpdu The acknowledged MPDU.
+ */
+static void
+DataAcked(Ptr<const WifiMpdu> mpdu)
+{
+    if (mpdu->GetHeader().IsData())
+    {
+        g_updates++;
+    }
+}
+
+/**
+ * MacTxDataFailed trace sink; counts failed data transmissions.
+ *
+ * \param address The receiver.
+ */
+static void
+DataFailed(Mac48Address address)
+{
+    g_updates++;
+}
+
+/**
+ * \return the peak resident set size of this process in bytes
+ */
+static uint64_t
+PeakRssBytes()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // KiB on Linux
+}
+
+/**
+ * Build and run the AP scenario with one remote station manager.
+ *
+ * \param manager Remote station manager TypeId.
+ * \param nSta Number of stations.
+ * \param simTime Simulated time (seconds).
+ */
+static void
+RunManager(const std::string& manager, uint32_t nSta, double simTime)
+{
+    NodeContainer apNode;
+    apNode.Create(1);
+    NodeContainer staNodes;
+    staNodes.Create(nSta);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+    if (manager == "ns3::ConstantRateWifiManager")
+    {
+        // The manager's default mode is a legacy OFDM rate; pin an HT MCS
+        wifi.SetRemoteStationManager(manager,
+                                     "DataMode",
+                                     StringValue("HtMcs7"),
+                                     "ControlMode",
+                                     StringValue("HtMcs0"));
+    }
+    else
+    {
+        wifi.SetRemoteStationManager(manager);
+    }
+
+    WifiMacHelper mac;
+    Ssid ssid = Ssid("rate-manager-benchmark");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid), "ActiveProbing", BooleanValue(false));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevices = wifi.Install(phy, mac, apNode);
+
+    Ptr<WifiNetDevice> apDevice = DynamicCast<WifiNetDevice>(apDevices.Get(0));
+    apDevice->GetMac()->TraceConnectWithoutContext("AckedMpdu", MakeCallback(&DataAcked));
+    apDevice->GetRemoteStationManager()->TraceConnectWithoutContext("MacTxDataFailed",
+                                                                    MakeCallback(&DataFailed));
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::UniformDiscPositionAllocator",
+                                  "rho",
+                                  DoubleValue(10.0));
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    InternetStackHelper stack;
+    stack.Install(apNode);
+    stack.Install(staNodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.0.0.0");
+    address.Assign(apDevices);
+    Ipv4InterfaceContainer staInterfaces = address.Assign(staDevices);
+
+    UdpServerHelper server(9);
+    ApplicationContainer serverApps = server.Install(staNodes);
+    serverApps.Start(Seconds(0.5));
+
+    for (uint32_t i = 0; i < nSta; i++)
+    {
+        UdpClientHelper client(staInterfaces.GetAddress(i), 9);
+        client.SetAttribute("MaxPackets", UintegerValue(0));
+        client.SetAttribute("Interval", TimeValue(MilliSeconds(100)));
+        client.SetAttribute("PacketSize", UintegerValue(100));
+        ApplicationContainer clientApp = client.Install(apNode);
+        // Spread the flows over one interval
+        clientApp.Start(Seconds(1.0) + MilliSeconds(100) * i / nSta);
+    }
+
+    g_updates = 0;
+    uint64_t rssBefore = PeakRssBytes();
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Stop(Seconds(simTime));
+    Simulator::Run();
+    double wall =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t rssAfter = PeakRssBytes();
+    uint64_t events = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    std::cout << std::left << std::setw(34) << manager << std::right << std::setw(8) << nSta
+              << std::setw(12) << g_updates << std::setw(14) << std::fixed
+              << std::setprecision(0) << g_updates / wall << std::setw(14)
+              << (rssAfter - rssBefore) / nSta << std::setw(12) << std::setprecision(3) << wall
+              << std::setw(14) << std::setprecision(0) << events / wall << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nSta = 1000;
+    double simTime = 5.0;
+    std::string managers =
+        "ns3::MinstrelHtWifiManager,ns3::IdealWifiManager,ns3::ConstantRateWifiManager";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nSta", "Number of associated stations", nSta);
+    cmd.AddValue("simTime", "Simulated time (seconds)", simTime);
+    cmd.AddValue("managers", "Comma separated remote station manager TypeIds", managers);
+    cmd.Parse(argc, argv);
+
+    std::vector<std::string> list;
+    std::istringstream stream(managers);
+    std::string manager;
+    while (std::getline(stream, manager, ','))
+    {
+        list.push_back(manager);
+    }
+
+    std::cout << std::left << std::setw(34) << "manager" << std::right << std::setw(8) << "nSta"
+              << std::setw(12) << "updates" << std::setw(14) << "updates/s" << std::setw(14)
+              << "RSSgrow/STA" << std::setw(12) << "wall(s)" << std::setw(14) << "events/s"
+              << std::endl;
+
+    // One worker: runs are sequential but each has a fresh process
+    uint32_t failed = RunInWorkers(list.size(), 1, [&](uint32_t k) {
+        RunManager(list[k], nSta, simTime);
+        return 0;
+    });
+
+    return failed == 0 ? 0 : 1;
+}
@@ -8,6 +8,14 @@
 #include "ns3/netanim-module.h" //NetAnim için gerekli header
 #include "ns3/mobility-module.h" //Mobility için gerekli header
 
+#ifdef NS3_MPI
+#include "ns3/mpi-interface.h"
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
 
 
 using namespace ns3;
@@ -17,27 +25,57 @@ NS_LOG_COMPONENT_DEFINE("RingScriptExample");
 int
 main(int argc, char* argv[])
 {
+    uint32_t nNodes = 4;
+    bool parallel = false;
+    bool tracing = true;
+    bool verbose = true;
+
     CommandLine cmd(__FILE__);
+    cmd.AddValue("nNodes", "Number of ring nodes (minimum 3)", nNodes);
+    cmd.AddValue("parallel",
+                 "Partition the ring across MPI ranks (needs an MPI-enabled build)",
+                 parallel);
+    cmd.AddValue("tracing", "Enable NetAnim and pcap output", tracing);
+    cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
     cmd.Parse(argc, argv);
 
+    if (nNodes < 3)
+    {
+        NS_FATAL_ERROR("nNodes must be at least 3");
+    }
+
+    uint32_t systemId = 0;
+    uint32_t systemCount = 1;
+    if (parallel)
+    {
+#ifdef NS3_MPI
+        // The distributed simulator derives its lookahead from the smallest
+        // delay of the point-to-point links that cross partitions (2 ms here)
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::DistributedSimulatorImpl"));
+        MpiInterface::Enable(&argc, &argv);
+        systemId = MpiInterface::GetSystemId();
+        systemCount = MpiInterface::GetSize();
+#else
+        NS_FATAL_ERROR("parallel=true needs ns-3 configured with --enable-mpi");
+#endif
+    }
+
     Time::SetResolution(Time::NS);
-    LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    if (verbose)
+    {
+        LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    }
 
     //CREATING NODES AND GROUPING THEM ACCORDING TO THE RING TOPOLOGY
-    NodeContainer nodes, node01, node12, node23, node30;
-    nodes.Create(4);
-    node01.Add(nodes.Get(0));
-    node01.Add(nodes.Get(1));
-
-    node12.Add(nodes.Get(1));
-    node12.Add(nodes.Get(2));
-
-    node23.Add(nodes.Get(2));
-    node23.Add(nodes.Get(3));
-
-    node30.Add(nodes.Get(3));
-    node30.Add(nodes.Get(0));
+    //Contiguous arcs are the minimum cut of a ring: each partition
+    //shares exactly two links with its neighbours.
+    NodeContainer nodes;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        nodes.Add(CreateObject<Node>(i * systemCount / nNodes));
+    }
 
     //CREATING POINT TO POINT LINKS BETWEEN NODES
     PointToPointHelper pointToPoint;
@@ -45,55 +83,88 @@ main(int argc, char* argv[])
     pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
 
     //MAKING DEVICES ..
-    NetDeviceContainer devices01, devices12, devices23, devices30;
-    devices01 = pointToPoint.Install(node01);
-    devices12 = pointToPoint.Install(node12);
-    devices23 = pointToPoint.Install(node23);
-    devices30 = pointToPoint.Install(node30);
+    //Links that join two partitions become PointToPointRemoteChannels
+    std::vector<NetDeviceContainer> devices;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        devices.push_back(pointToPoint.Install(nodes.Get(i), nodes.Get((i + 1) % nNodes)));
+    }
 
     //INSTALLING IP STACK
     InternetStackHelper stack;
     stack.Install(nodes);
 
     //ASSIGNING IP ADDRESSES
+    //Small rings keep one /8 per link (54.0.0.0 up to 126.0.0.0, below the
+    //127.0.0.0/8 loopback network); larger rings use /30 links inside
+    //10.0.0.0/8, which holds 2^22 of them.
+    const uint32_t maxSlash8Links = 127 - 54;
+    NS_ABORT_MSG_IF(nNodes > (1U << 22),
+                    "nNodes=" << nNodes << " needs more /30 links than 10.0.0.0/8 holds");
     Ipv4AddressHelper address;
-    
-    address.SetBase("54.0.0.0", "255.0.0.0");
-    Ipv4InterfaceContainer interfaces01 = address.Assign(devices01);
-
-    address.SetBase("55.0.0.0", "255.0.0.0");
-    Ipv4InterfaceContainer interfaces12 = address.Assign(devices12);
-
-    address.SetBase("56.0.0.0", "255.0.0.0");
-    Ipv4InterfaceContainer interfaces23 = address.Assign(devices23);
-
-    address.SetBase("57.0.0.0", "255.0.0.0");
-    Ipv4InterfaceContainer interfaces30 = address.Assign(devices30);
+    std::vector<Ipv4InterfaceContainer> interfaces;
+    if (nNodes <= maxSlash8Links)
+    {
+        for (uint32_t i = 0; i < nNodes; i++)
+        {
+            std::string base = std::to_string(54 + i) + ".0.0.0";
+            address.SetBase(base.c_str(), "255.0.0.0");
+            interfaces.push_back(address.Assign(devices[i]));
+        }
+    }
+    else
+    {
+        address.SetBase("10.0.0.0", "255.255.255.252");
+        for (uint32_t i = 0; i < nNodes; i++)
+        {
+            interfaces.push_back(address.Assign(devices[i]));
+            address.NewNetwork();
+        }
+    }
 
     //CREATING SERVERS
+    //Applications are installed only on the partition that owns the node
     UdpEchoServerHelper echoServer(9);
 
-    ApplicationContainer serverApps = echoServer.Install(nodes.Get(0));
-    serverApps.Start(Seconds(2.0));
-    serverApps.Stop(Seconds(10.0));
+    if (nodes.Get(0)->GetSystemId() == systemId)
+    {
+        ApplicationContainer serverApps = echoServer.Install(nodes.Get(0));
+        serverApps.Start(Seconds(2.0));
+        serverApps.Stop(Seconds(10.0));
+    }
 
     //CREATING CLIENTS
-    UdpEchoClientHelper echoClient(interfaces01.GetAddress(0), 9);
+    UdpEchoClientHelper echoClient(interfaces[0].GetAddress(0), 9);
     echoClient.SetAttribute("MaxPackets", UintegerValue(5));
     echoClient.SetAttribute("Interval", TimeValue(Seconds(1.0)));
     echoClient.SetAttribute("PacketSize", UintegerValue(1024));
 
-    ApplicationContainer clientApps = echoClient.Install(nodes.Get(2));
-    clientApps.Start(Seconds(1.0));
-    clientApps.Stop(Seconds(10.0));
+    if (nodes.Get(2)->GetSystemId() == systemId)
+    {
+        ApplicationContainer clientApps = echoClient.Install(nodes.Get(2));
+        clientApps.Start(Seconds(1.0));
+        clientApps.Stop(Seconds(10.0));
+    }
 
     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
-    AnimationInterface anim("ring.xml");
-    pointToPoint.EnablePcapAll("ring");
-    
+    std::unique_ptr<AnimationInterface> anim;
+    if (tracing)
+    {
+        anim = std::make_unique<AnimationInterface>("ring.xml");
+        pointToPoint.EnablePcapAll("ring");
+    }
+
 
+    Simulator::Stop(Seconds(10.0));
     Simulator::Run();
     Simulator::Destroy();
+
+#ifdef NS3_MPI
+    if (parallel)
+    {
+        MpiInterface::Disable();
+    }
+#endif
     return 0;
 }
@@ -0,0 +1,792 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fused-propagation-loss-model.h"
+#include "geometric-rate-error-model.h"
+#include "parallel-runs.h"
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/ssid.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Benchmark suite built from the repository's scenarios
+//
+// Each scenario is a scaled-up, deterministic version of one script, with
+// logging, pcap and NetAnim off:
+//
+//   first     10*scale independent point-to-point echo pairs (first_demo.cc)
+//   ring      50*scale node point-to-point ring, every node echoes to node 0 (ring.cc)
+//   mesh      8*scale node full point-to-point mesh, echoes to node 0 (mesh.cc)
+//   twoLANs   two 20*scale node CSMA LANs joined by two routers (twoLANsTwoRouters.cc)
+//   third     10*scale Wi-Fi STAs, an AP and a CSMA LAN (third_v1.cc)
+//   v2v       50*scale vehicles broadcasting 10 Hz BSMs over 802.11p (wifi-v2v-demo.cc)
+//   fifth     10*scale node TCP chain with the geometric error model (fifth-linear.cc)
+//
+// Every scenario runs in its own process with RngSeed=1, RngRun=1. One
+// JSON object per scenario is written to --output and to stdout:
+// events/s, simulated seconds per wall second, peak RSS and heap
+// allocations per event. With --baseline the results are compared
+// against a file written earlier with --writeBaseline. Any metric more
+// than --tolerance worse than the baseline is reported, and the program
+// exits with status 1.
+//
+// ./ns3 run "scenario-benchmark --scale=4 --baseline=bench-baseline.jsonl"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("ScenarioBenchmark");
+
+static uint64_t g_allocations = 0; //!< operator new calls in this process
+
+// Count heap allocations of the whole program, ns-3 libraries included
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations++;
+    return std::malloc(size ? size : 1);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept
+{
+    g_allocations++;
+    void* p = nullptr;
+    std::size_t alignment = std::max(static_cast<std::size_t>(align), sizeof(void*));
+    return posix_memalign(&p, alignment, size ? size : 1) == 0 ? p : nullptr;
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, align, tag);
+}
+
+void*
+operator new(std::size_t size, std::align_val_t align)
+{
+    if (void* p = operator new(size, align, std::nothrow))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size, std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Install UDP echo clients on \p clients towards \p server.
+ *
+ * \param clients Client nodes.
+ * \param server Server address.
+ * \param interval Packet interval.
+ * \param stop Client stop time.
+ */
+static void
+InstallEchoClients(NodeContainer clients, Ipv4Address server, Time interval, Time stop)
+{
+    UdpEchoClientHelper echoClient(server, 9);
+    echoClient.SetAttribute("MaxPackets", UintegerValue(0));
+    echoClient.SetAttribute("Interval", TimeValue(interval));
+    echoClient.SetAttribute("PacketSize", UintegerValue(1024));
+    ApplicationContainer clientApps = echoClient.Install(clients);
+    clientApps.Start(Seconds(1.0));
+    clientApps.Stop(stop);
+}
+
+/**
+ * first_demo.cc: tracks its 5 Mbps / 5 ms link and 1024-byte echo packets.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildFirst(uint32_t scale)
+{
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("5ms"));
+    InternetStackHelper stack;
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    UdpEchoServerHelper echoServer(9);
+
+    for (uint32_t i = 0; i < 10 * scale; i++)
+    {
+        NodeContainer nodes;
+        nodes.Create(2);
+        NetDeviceContainer devices = pointToPoint.Install(nodes);
+        stack.Install(nodes);
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+        address.NewNetwork();
+
+        echoServer.Install(nodes.Get(1)).Start(Seconds(0.5));
+        InstallEchoClients(nodes.Get(0), interfaces.GetAddress(1), MilliSeconds(10), Seconds(11));
+    }
+    Simulator::Stop(Seconds(12.0));
+}
+
+/**
+ * ring.cc: tracks its 100 Mbps / 2 ms links, the echo server on node 0 and
+ * the 1024-byte echo packets.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildRing(uint32_t scale)
+{
+    uint32_t nNodes = 50 * scale;
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    Ipv4InterfaceContainer first;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        NetDeviceContainer devices =
+            pointToPoint.Install(nodes.Get(i), nodes.Get((i + 1) % nNodes));
+        Ipv4InterfaceContainer interfaces = address.Assign(devices);
+        address.NewNetwork();
+        if (i == 0)
+        {
+            first = interfaces;
+        }
+    }
+
+    UdpEchoServerHelper echoServer(9);
+    echoServer.Install(nodes.Get(0)).Start(Seconds(0.5));
+    NodeContainer clients;
+    for (uint32_t i = 1; i < nNodes; i++)
+    {
+        clients.Add(nodes.Get(i));
+    }
+    InstallEchoClients(clients, first.GetAddress(0), MilliSeconds(10), Seconds(11));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Simulator::Stop(Seconds(12.0));
+}
+
+/**
+ * mesh.cc: tracks its 100 Mbps / 2 ms links, the echo server on node 0 and
+ * the 1024-byte echo packets.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildMesh(uint32_t scale)
+{
+    uint32_t nNodes = 8 * scale;
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    Ipv4Address server;
+    for (uint32_t i = 0; i < nNodes; i++)
+    {
+        for (uint32_t j = i + 1; j < nNodes; j++)
+        {
+            NetDeviceContainer devices = pointToPoint.Install(nodes.Get(i), nodes.Get(j));
+            Ipv4InterfaceContainer interfaces = address.Assign(devices);
+            address.NewNetwork();
+            if (i == 0 && j == 1)
+            {
+                server = interfaces.GetAddress(0);
+            }
+        }
+    }
+
+    UdpEchoServerHelper echoServer(9);
+    echoServer.Install(nodes.Get(0)).Start(Seconds(0.5));
+    NodeContainer clients;
+    for (uint32_t i = 1; i < nNodes; i++)
+    {
+        clients.Add(nodes.Get(i));
+    }
+    InstallEchoClients(clients, server, MilliSeconds(10), Seconds(11));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Simulator::Stop(Seconds(12.0));
+}
+
+/**
+ * twoLANsTwoRouters.cc: tracks its 100 Mbps / 6560 ns LANs, the 10 Mbps /
+ * 2 ms router link and the 200 ms interval of the 1024-byte echoes.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildTwoLans(uint32_t scale)
+{
+    uint32_t nHosts = 20 * scale;
+    NodeContainer lan1Hosts;
+    lan1Hosts.Create(nHosts);
+    NodeContainer lan2Hosts;
+    lan2Hosts.Create(nHosts);
+    NodeContainer routers;
+    routers.Create(2);
+
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("100Mbps"));
+    csma.SetChannelAttribute("Delay", TimeValue(NanoSeconds(6560)));
+    NodeContainer lan1(lan1Hosts, routers.Get(0));
+    NodeContainer lan2(lan2Hosts, routers.Get(1));
+    NetDeviceContainer lan1Devices = csma.Install(lan1);
+    NetDeviceContainer lan2Devices = csma.Install(lan2);
+
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer routerDevices = pointToPoint.Install(routers);
+
+    InternetStackHelper stack;
+    stack.Install(lan1);
+    stack.Install(lan2);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.0.0");
+    address.Assign(lan1Devices);
+    address.SetBase("10.2.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer lan2Interfaces = address.Assign(lan2Devices);
+    address.SetBase("10.100.0.0", "255.255.255.0");
+    address.Assign(routerDevices);
+
+    UdpEchoServerHelper echoServer(9);
+    echoServer.Install(lan2Hosts).Start(Seconds(0.5));
+    InstallEchoClients(lan1Hosts, lan2Interfaces.GetAddress(0), MilliSeconds(200), Seconds(11));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Simulator::Stop(Seconds(12.0));
+}
+
+/**
+ * third_v1.cc: tracks its 5 Mbps / 2 ms link, the 3-host CSMA LAN, the
+ * default rateManager and channel, and the STA grid and random walk.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildThird(uint32_t scale)
+{
+    uint32_t nWifi = 10 * scale;
+    NodeContainer p2pNodes;
+    p2pNodes.Create(2);
+    PointToPointHelper pointToPoint;
+    pointToPoint.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    pointToPoint.SetChannelAttribute("Delay", StringValue("2ms"));
+    NetDeviceContainer p2pDevices = pointToPoint.Install(p2pNodes);
+
+    NodeContainer csmaNodes;
+    csmaNodes.Add(p2pNodes.Get(1));
+    csmaNodes.Create(3);
+    CsmaHelper csma;
+    csma.SetChannelAttribute("DataRate", StringValue("100Mbps"));
+    csma.SetChannelAttribute("Delay", TimeValue(NanoSeconds(6560)));
+    NetDeviceContainer csmaDevices = csma.Install(csmaNodes);
+
+    NodeContainer wifiStaNodes;
+    wifiStaNodes.Create(nWifi);
+    NodeContainer wifiApNode = p2pNodes.Get(0);
+
+    // third_v1's default channel (cacheLoss=false): plain log-distance loss
+    YansWifiPhyHelper phy;
+    phy.SetChannel(YansWifiChannelHelper::Default().Create());
+
+    WifiHelper wifi;
+    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    WifiMacHelper mac;
+    Ssid ssid = Ssid("ns-3-ssid");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid), "ActiveProbing", BooleanValue(false));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, wifiStaNodes);
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevices = wifi.Install(phy, mac, wifiApNode);
+
+    uint32_t gridWidth = static_cast<uint32_t>(std::ceil(std::sqrt(nWifi)));
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "MinX",
+                                  DoubleValue(0.0),
+                                  "MinY",
+                                  DoubleValue(0.0),
+                                  "DeltaX",
+                                  DoubleValue(50.0 / gridWidth),
+                                  "DeltaY",
+                                  DoubleValue(50.0 / gridWidth),
+                                  "GridWidth",
+                                  UintegerValue(gridWidth),
+                                  "LayoutType",
+                                  StringValue("RowFirst"));
+    mobility.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
+                              "Bounds",
+                              RectangleValue(Rectangle(-50, 50, -50, 50)));
+    mobility.Install(wifiStaNodes);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(wifiApNode);
+
+    InternetStackHelper stack;
+    stack.Install(csmaNodes);
+    stack.Install(wifiApNode);
+    stack.Install(wifiStaNodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(p2pDevices);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer csmaInterfaces = address.Assign(csmaDevices);
+    address.SetBase("10.2.0.0", "255.255.0.0");
+    address.Assign(staDevices);
+    address.Assign(apDevices);
+
+    UdpEchoServerHelper echoServer(9);
+    echoServer.Install(csmaNodes.Get(3)).Start(Seconds(0.5));
+    InstallEchoClients(wifiStaNodes, csmaInterfaces.GetAddress(3), MilliSeconds(100), Seconds(9));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Simulator::Stop(Seconds(10.0));
+}
+
+/**
+ * wifi-v2v-demo.cc: tracks its lane speeds, 802.11p rate, loss chain at
+ * 5.9 GHz and the 200-byte BSM every 100 ms.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildV2v(uint32_t scale)
+{
+    uint32_t nVehicles = 50 * scale;
+    NodeContainer nodes;
+    nodes.Create(nVehicles);
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+    const double laneSpeeds[] = {25.0, 22.0, 19.0, 17.0, 15.0};
+    for (uint32_t i = 0; i < nVehicles; i++)
+    {
+        auto mov = nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+        mov->SetPosition(Vector(30.0 * i, (i % 5) * 4.0, 0.0));
+        mov->SetVelocity(Vector(laneSpeeds[i % 5], 0.0, 0.0));
+    }
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211p);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6MbpsBW10MHz"),
+                                 "ControlMode",
+                                 StringValue("OfdmRate6MbpsBW10MHz"));
+    YansWifiChannelHelper wifiChannel;
+    wifiChannel.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    wifiChannel.AddPropagationLoss("ns3::LogDistanceFriisPropagationLossModel",
+                                   "Frequency",
+                                   DoubleValue(5.9e9));
+    YansWifiPhyHelper wifiPhy;
+    wifiPhy.SetChannel(wifiChannel.Create());
+    WifiMacHelper wifiMac;
+    wifiMac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(wifiPhy, wifiMac, nodes);
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.0.0.0");
+    ipv4.Assign(devices);
+
+    // 200-byte BSM every 100 ms to the broadcast address
+    OnOffHelper bsm("ns3::UdpSocketFactory",
+                    InetSocketAddress(Ipv4Address("255.255.255.255"), 9));
+    bsm.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1000]"));
+    bsm.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
+    bsm.SetAttribute("PacketSize", UintegerValue(200));
+    bsm.SetAttribute("DataRate", DataRateValue(DataRate("16kbps")));
+    ApplicationContainer apps = bsm.Install(nodes);
+    apps.Start(Seconds(1.0));
+    apps.Stop(Seconds(10.0));
+
+    PacketSinkHelper sink("ns3::UdpSocketFactory", InetSocketAddress(Ipv4Address::GetAny(), 9));
+    sink.Install(nodes);
+
+    Simulator::Stop(Seconds(11.0));
+}
+
+/**
+ * fifth-linear.cc: tracks its default mAlgo, mRate, mDelay, mAppRate and
+ * mPacketSize, InitialCwnd 1 and the 1e-5 error rate.
+ *
+ * \param scale Scale factor.
+ */
+static void
+BuildFifth(uint32_t scale)
+{
+    uint32_t nNodes = 10 * scale;
+    Config::SetDefault("ns3::TcpL4Protocol::SocketType", StringValue("ns3::TcpCubic"));
+    Config::SetDefault("ns3::TcpSocket::InitialCwnd", UintegerValue(1));
+    Config::SetDefault("ns3::TcpL4Protocol::RecoveryType",
+                       TypeIdValue(TypeId::LookupByName("ns3::TcpClassicRecovery")));
+
+    NodeContainer nodes;
+    nodes.Create(nNodes);
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("5Mbps"));
+    p2p.SetChannelAttribute("Delay", StringValue("2ms"));
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    Ptr<RateErrorModel> errorModel = CreateObject<GeometricRateErrorModel>();
+    errorModel->SetAttribute("ErrorRate", DoubleValue(0.00001));
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    Ipv4InterfaceContainer last;
+    for (uint32_t i = 0; i + 1 < nNodes; i++)
+    {
+        NetDeviceContainer devices = p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+        devices.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(errorModel));
+        last = address.Assign(devices);
+        address.NewNetwork();
+    }
+
+    uint16_t port = 8080;
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    sinkHelper.Install(nodes.Get(nNodes - 1)).Start(Seconds(0.0));
+
+    OnOffHelper source("ns3::TcpSocketFactory", InetSocketAddress(last.GetAddress(1), port));
+    source.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1000]"));
+    source.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
+    source.SetAttribute("PacketSize", UintegerValue(1040));
+    source.SetAttribute("DataRate", DataRateValue(DataRate("1Mbps")));
+    source.Install(nodes.Get(0)).Start(Seconds(1.0));
+
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    Simulator::Stop(Seconds(20.0));
+}
+
+/**
+ * Build, run and measure one scenario; append its JSON line to \p output.
+ *
+ * \param name Scenario name.
+ * \param build Scenario builder.
+ * \param scale Scale factor.
+ * \param output Results file.
+ * \return false if the results file cannot be written
+ */
+static bool
+RunScenario(const std::string& name,
+            const std::function<void(uint32_t)>& build,
+            uint32_t scale,
+            const std::string& output)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    build(scale);
+
+    uint64_t allocationsBefore = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    // A scenario too small to measure would otherwise write inf rates
+    double wall = std::max(
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+        1e-9);
+    uint64_t allocations = g_allocations - allocationsBefore;
+    uint64_t events = Simulator::GetEventCount();
+    double simSeconds = Simulator::Now().GetSeconds();
+    Simulator::Destroy();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    std::ofstream out(output, std::ios::app);
+    if (!out)
+    {
+        return false;
+    }
+    out << "{\"scenario\":\"" << name << "\",\"scale\":" << scale << ",\"events\":" << events
+        << ",\"wall_s\":" << wall << ",\"events_per_s\":" << events / wall
+        << ",\"sim_s_per_wall_s\":" << simSeconds / wall
+        << ",\"peak_rss_kb\":" << usage.ru_maxrss
+        << ",\"allocs_per_event\":" << (events ? double(allocations) / events : 0.0) << "}"
+        << std::endl;
+    return true;
+}
+
+/**
+ * \param line One JSON object as written by RunScenario.
+ * \param key Field name.
+ * \return the field's raw value text, or "" if absent
+ */
+static std::string
+JsonField(const std::string& line, const std::string& key)
+{
+    std::string tag = "\"" + key + "\":";
+    std::size_t pos = line.find(tag);
+    if (pos == std::string::npos)
+    {
+        return "";
+    }
+    pos += tag.size();
+    std::size_t end = line.find_first_of(",}", pos);
+    std::string value = line.substr(pos, end - pos);
+    if (value.size() >= 2 && value.front() == '"')
+    {
+        value = value.substr(1, value.size() - 2);
+    }
+    return value;
+}
+
+/**
+ * \param fileName JSON lines file.
+ * \return its lines keyed by "scenario/scale"
+ */
+static std::map<std::string, std::string>
+ReadResults(const std::string& fileName)
+{
+    std::map<std::string, std::string> results;
+    std::ifstream in(fileName);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        if (!line.empty())
+        {
+            results[JsonField(line, "scenario") + "/" + JsonField(line, "scale")] = line;
+        }
+    }
+    return results;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t scale = 1;
+    std::string scenarios = "first,ring,mesh,twoLANs,third,v2v,fifth";
+    std::string output = "scenario-benchmark.jsonl";
+    std::string baseline = "";
+    bool writeBaseline = false;
+    double tolerance = 0.10;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("scale", "Scale factor applied to every scenario's size", scale);
+    cmd.AddValue("scenarios", "Comma separated scenarios to run", scenarios);
+    cmd.AddValue("output", "JSON lines results file", output);
+    cmd.AddValue("baseline", "Baseline JSON lines file to compare against", baseline);
+    cmd.AddValue("writeBaseline", "Store this run's results as the baseline", writeBaseline);
+    cmd.AddValue("tolerance", "Allowed relative regression before failing", tolerance);
+    cmd.Parse(argc, argv);
+
+    const std::map<std::string, std::function<void(uint32_t)>> builders = {
+        {"first", &BuildFirst},
+        {"ring", &BuildRing},
+        {"mesh", &BuildMesh},
+        {"twoLANs", &BuildTwoLans},
+        {"third", &BuildThird},
+        {"v2v", &BuildV2v},
+        {"fifth", &BuildFifth},
+    };
+
+    std::vector<std::string> names;
+    std::istringstream list(scenarios);
+    std::string name;
+    while (std::getline(list, name, ','))
+    {
+        NS_ABORT_MSG_IF(builders.count(name) == 0, "Unknown scenario " << name);
+        names.push_back(name);
+    }
+
+    std::ofstream(output, std::ios::trunc);
+    // One worker: no scenario competes with another for cores or memory bandwidth
+    uint32_t failed = RunInWorkers(names.size(), 1, [&](uint32_t k) {
+        return RunScenario(names[k], builders.at(names[k]), scale, output) ? 0 : 1;
+    });
+    NS_ABORT_MSG_IF(failed != 0, failed << " scenarios failed");
+
+    std::map<std::string, std::string> current = ReadResults(output);
+    for (const auto& [key, line] : current)
+    {
+        std::cout << line << std::endl;
+    }
+
+    if (writeBaseline)
+    {
+        NS_ABORT_MSG_IF(baseline.empty(), "writeBaseline needs --baseline=<file>");
+        std::ifstream in(output);
+        std::ofstream out(baseline, std::ios::trunc);
+        out << in.rdbuf();
+        return 0;
+    }
+    if (baseline.empty())
+    {
+        return 0;
+    }
+
+    // Higher is better for throughput metrics, lower for footprint metrics
+    const std::vector<std::pair<std::string, bool>> metrics = {
+        {"events_per_s", true},
+        {"sim_s_per_wall_s", true},
+        {"peak_rss_kb", false},
+        {"allocs_per_event", false},
+    };
+    std::map<std::string, std::string> reference = ReadResults(baseline);
+    uint32_t regressions = 0;
+    for (const auto& [key, line] : current)
+    {
+        auto it = reference.find(key);
+        if (it == reference.end())
+        {
+            std::cout << key << ": no baseline" << std::endl;
+            continue;
+        }
+        for (const auto& [metric, higherIsBetter] : metrics)
+        {
+            std::string baselineValue = JsonField(it->second, metric);
+            if (baselineValue.empty())
+            {
+                // Baselines written before a metric was added
+                std::cout << key << " " << metric << ": no baseline" << std::endl;
+                continue;
+            }
+            double now = std::stod(JsonField(line, metric));
+            double then = std::stod(baselineValue);
+            bool worse = higherIsBetter ? now < then * (1 - tolerance)
+                                        : now > then * (1 + tolerance);
+            if (worse)
+            {
+                std::cout << "REGRESSION " << key << " " << metric << ": " << then << " -> "
+                          << now << std::endl;
+                regressions++;
+            }
+        }
+    }
+    return regressions == 0 ? 0 : 1;
+}
@@ -6,15 +6,30 @@
 #include "ns3/network-module.h"
 #include "ns3/wifi-module.h"
 
+#include "cached-propagation-loss-model.h"
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE("WirelessMultiDeviceSimulation");
 
 int main(int argc, char* argv[])
 {
+    bool cacheLoss = false;
+    double lossQuantum = 0;
+    bool verbose = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("cacheLoss", "Hareket etmeyen düğüm çiftleri için yol kaybını önbellekle", cacheLoss);
+    cmd.AddValue("lossQuantum", "Önbellek için konum ızgarası (m); 0 sonuçları birebir korur", lossQuantum);
+    cmd.AddValue("verbose", "Echo uygulamalarının loglarını yazdır", verbose);
+    cmd.Parse(argc, argv);
+
     // Log seviyelerini ayarla
-    LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    if (verbose)
+    {
+        LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    }
 
     // Paket izleme için gerekli ayarlar
     Packet::EnablePrinting();
@@ -36,9 +51,16 @@ int main(int argc, char* argv[])
     allStations.Add(smartphones);
 
     // 2. Kablosuz aygıtları yapılandır
-    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    // Default() ile aynı modeller; LogDistance kaybı çift başına önbellekte
+    Ptr<CachedPropagationLossModel> lossCache = CreateObject<CachedPropagationLossModel>();
+    lossCache->SetInner(CreateObject<LogDistancePropagationLossModel>());
+    lossCache->SetAttribute("Enabled", BooleanValue(cacheLoss));
+    lossCache->SetAttribute("Quantum", DoubleValue(lossQuantum));
+    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel>();
+    channel->SetPropagationLossModel(lossCache);
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
     YansWifiPhyHelper phy;
-    phy.SetChannel(channel.Create());
+    phy.SetChannel(channel);
 
     WifiHelper wifi;
     wifi.SetStandard(WIFI_STANDARD_80211n);
@@ -175,6 +197,14 @@ int main(int argc, char* argv[])
     phy.EnablePcapAll("wireless-trace");
 
     Simulator::Run();
+
+    if (cacheLoss)
+    {
+        std::cout << "Kayıp önbelleği: isabet=" << lossCache->GetHits()
+                  << " ıskalama=" << lossCache->GetMisses()
+                  << " isabet oranı=" << lossCache->GetHitRate() << std::endl;
+    }
+
     Simulator::Destroy();
 
     return 0;
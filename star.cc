@@ -17,12 +17,18 @@ NS_LOG_COMPONENT_DEFINE("StarScriptExample");
 int
 main(int argc, char* argv[])
 {
+    bool verbose = true;
+
     CommandLine cmd(__FILE__);
+    cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
     cmd.Parse(argc, argv);
 
     Time::SetResolution(Time::NS);
-    LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
-    LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    if (verbose)
+    {
+        LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
+        LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
+    }
 
     //CREATING NODES AND GROUPING THEM ACCORDING TO THE RING TOPOLOGY
     NodeContainer nodes, node01, node02, node03, node04;
@@ -0,0 +1,57 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef SWITCHED_LAN_H
+#define SWITCHED_LAN_H
+
+#include "ns3/bridge-module.h"
+#include "ns3/csma-module.h"
+#include "ns3/network-module.h"
+
+namespace ns3
+{
+
+/**
+ * Build a LAN as a star around a learning switch instead of one shared bus.
+ *
+ * Every host gets its own two-device CSMA link to \p bridge, and the
+ * bridge's ends of those links are joined by a BridgeNetDevice. The bridge
+ * learns source MAC addresses and forwards a known unicast frame out of one
+ * port only, so one transmission schedules receptions on two devices
+ * instead of on every device of the LAN.
+ *
+ * This is not a full-duplex switch. Each port link is still a half-duplex
+ * CsmaChannel, so a host and its switch port back off against each other.
+ * The bridge has no queues of its own. Frames wait only in the TxQueue of
+ * the outgoing port's CsmaNetDevice. Broadcasts and frames to unlearned
+ * addresses are flooded to every port.
+ *
+ * The host devices are ordinary CsmaNetDevices, so IP addressing, pcap and
+ * traces work on them as before. A promiscuous pcap on one host now sees
+ * only that host's link.
+ *
+ * \param csma Helper holding the link DataRate and Delay.
+ * \param hosts Nodes attached to the LAN.
+ * \param bridge Switch node; it needs no internet stack.
+ * \return The host devices, in \p hosts order.
+ */
+inline NetDeviceContainer
+InstallSwitchedLan(const CsmaHelper& csma, const NodeContainer& hosts, Ptr<Node> bridge)
+{
+    NetDeviceContainer hostDevices;
+    NetDeviceContainer bridgePorts;
+    for (uint32_t i = 0; i < hosts.GetN(); i++)
+    {
+        NetDeviceContainer link = csma.Install(NodeContainer(hosts.Get(i), bridge));
+        hostDevices.Add(link.Get(0));
+        bridgePorts.Add(link.Get(1));
+    }
+    BridgeHelper bridgeHelper;
+    bridgeHelper.Install(bridge, bridgePorts);
+    return hostDevices;
+}
+
+} // namespace ns3
+
+#endif /* SWITCHED_LAN_H */
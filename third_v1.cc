@@ -13,6 +13,11 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/wifi-mac-header.h"
 
+#include "cached-propagation-loss-model.h"
+#include "event-profiler.h"
+
+#include <cmath>
+
 // Default Network Topology
 //
 //   Wifi 10.1.3.0
@@ -57,23 +62,53 @@ main(int argc, char* argv[])
     uint32_t nCsma = 3;
     uint32_t nWifi = 3;
     bool tracing = false;
+    bool cacheLoss = false;
+    double lossQuantum = 0;
+    std::string rateManager = "ns3::MinstrelHtWifiManager";
+    bool profile = false;
+    bool monitor = true;
 
     CommandLine cmd(__FILE__);
     cmd.AddValue("nCsma", "Number of \"extra\" CSMA nodes/devices", nCsma);
     cmd.AddValue("nWifi", "Number of wifi STA devices", nWifi);
     cmd.AddValue("verbose", "Tell echo applications to log if true", verbose);
     cmd.AddValue("tracing", "Enable pcap tracing", tracing);
+    cmd.AddValue("cacheLoss", "Cache pairwise path loss between unmoved nodes", cacheLoss);
+    cmd.AddValue("lossQuantum",
+                 "Position grid (m) for the loss cache; 0 keeps results exact",
+                 lossQuantum);
+    cmd.AddValue("rateManager", "Wi-Fi remote station manager TypeId", rateManager);
+    cmd.AddValue("profile",
+                 "Write wall time per event-implementation type to third.folded",
+                 profile);
+
+    cmd.AddValue("monitor",
+                 "Print every frame received by every Wi-Fi PHY (turn off for large nWifi)",
+                 monitor);
 
     cmd.Parse(argc, argv);
 
-    // The underlying restriction of 18 is due to the grid position
-    // allocator's configuration; the grid layout will exceed the
-    // bounding box if more than 18 nodes are provided.
+    // The AP and the STAs share one subnet; a /16 holds 65533 of them
+    NS_ABORT_MSG_IF(nWifi > 65532, "nWifi must be at most 65532");
+
+    if (profile)
+    {
+        ObjectFactory schedulerFactory("ns3::ProfilingScheduler");
+        schedulerFactory.Set("ProfileFile", StringValue("third.folded"));
+        Simulator::SetScheduler(schedulerFactory);
+    }
+
+    // Up to 18 STAs keep the original 3-wide grid (5 m x 10 m spacing).
+    // Larger populations use a square grid squeezed into the same
+    // 50 m x 50 m quadrant of the random walk bounding box.
+    uint32_t gridWidth = 3;
+    double deltaX = 5.0;
+    double deltaY = 10.0;
     if (nWifi > 18)
     {
-        std::cout << "nWifi should be 18 or less; otherwise grid layout exceeds the bounding box"
-                  << std::endl;
-        return 1;
+        gridWidth = static_cast<uint32_t>(std::ceil(std::sqrt(nWifi)));
+        deltaX = 50.0 / gridWidth;
+        deltaY = deltaX;
     }
 
     if (verbose)
@@ -107,12 +142,32 @@ main(int argc, char* argv[])
     wifiStaNodes.Create(nWifi);
     NodeContainer wifiApNode = p2pNodes.Get(0);
 
-    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    // Same models as YansWifiChannelHelper::Default(), with the log-distance
+    // loss behind a per-pair cache: the AP never moves and the walkers are slow.
+    Ptr<CachedPropagationLossModel> lossCache = CreateObject<CachedPropagationLossModel>();
+    lossCache->SetInner(CreateObject<LogDistancePropagationLossModel>());
+    lossCache->SetAttribute("Enabled", BooleanValue(cacheLoss));
+    lossCache->SetAttribute("Quantum", DoubleValue(lossQuantum));
+    Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel>();
+    channel->SetPropagationLossModel(lossCache);
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel>());
     YansWifiPhyHelper phy;
-    phy.SetChannel(channel.Create());
+    phy.SetChannel(channel);
 
     WifiHelper wifi;
-    wifi.SetRemoteStationManager("ns3::MinstrelHtWifiManager");
+    if (rateManager == "ns3::ConstantRateWifiManager")
+    {
+        // The manager's default mode is a legacy OFDM rate; pin an HT MCS
+        wifi.SetRemoteStationManager(rateManager,
+                                     "DataMode",
+                                     StringValue("HtMcs7"),
+                                     "ControlMode",
+                                     StringValue("HtMcs0"));
+    }
+    else
+    {
+        wifi.SetRemoteStationManager(rateManager);
+    }
 
     WifiMacHelper mac;
     Ssid ssid = Ssid("ns-3-ssid");
@@ -133,11 +188,11 @@ main(int argc, char* argv[])
                                   "MinY",
                                   DoubleValue(0.0),
                                   "DeltaX",
-                                  DoubleValue(5.0),
+                                  DoubleValue(deltaX),
                                   "DeltaY",
-                                  DoubleValue(10.0),
+                                  DoubleValue(deltaY),
                                   "GridWidth",
-                                  UintegerValue(3),
+                                  UintegerValue(gridWidth),
                                   "LayoutType",
                                   StringValue("RowFirst"));
 
@@ -164,7 +219,15 @@ main(int argc, char* argv[])
     Ipv4InterfaceContainer csmaInterfaces;
     csmaInterfaces = address.Assign(csmaDevices);
 
-    address.SetBase("10.1.3.0", "255.255.255.0");
+    // Up to 253 STAs keep the original /24; larger populations get a /16
+    if (nWifi < 254)
+    {
+        address.SetBase("10.1.3.0", "255.255.255.0");
+    }
+    else
+    {
+        address.SetBase("10.2.0.0", "255.255.0.0");
+    }
     address.Assign(staDevices);
     address.Assign(apDevices);
 
@@ -186,8 +249,11 @@ main(int argc, char* argv[])
     Ipv4GlobalRoutingHelper::PopulateRoutingTables();
 
     Simulator::Stop(Seconds(10.0));
-    Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/MonitorSnifferRx",
-                    MakeCallback(&Monitor));
+    if (monitor)
+    {
+        Config::Connect("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/MonitorSnifferRx",
+                        MakeCallback(&Monitor));
+    }
 
     if (tracing)
     {
@@ -198,6 +264,14 @@ main(int argc, char* argv[])
     }
 
     Simulator::Run();
+
+    if (cacheLoss)
+    {
+        std::cout << "Loss cache: hits=" << lossCache->GetHits()
+                  << " misses=" << lossCache->GetMisses()
+                  << " hit rate=" << lossCache->GetHitRate() << std::endl;
+    }
+
     Simulator::Destroy();
     return 0;
 }
@@ -0,0 +1,186 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef THROUGHPUT_COLLECTOR_H
+#define THROUGHPUT_COLLECTOR_H
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * Per-flow receive throughput in fixed time buckets, streamed to a file.
+ *
+ * Every sink gets a slot of two counters, and its Rx trace is bound
+ * directly to that slot, so a reception is two increments with no lookup.
+ * At the end of each bucket one row per flow is appended to the output
+ * file and the counters are reset. Memory therefore depends only on the
+ * number of flows, not on the run length.
+ *
+ * The file starts with '#' lines: the metadata given to SetMetadata, then
+ * the column names with their types and units. The rows are
+ * whitespace-separated, as gnuplot and the existing CSVs expect. Rows are
+ * stamped with the end of their bucket; the rows written at Start are
+ * empty.
+ *
+ * Bucketing keeps one event pending until Stop is called. A run that ends
+ * with Simulator::Stop needs no Stop; one that runs until the event queue
+ * is empty must call Stop, or it never ends.
+ */
+class ThroughputCollector : public SimpleRefCount<ThroughputCollector>
+{
+  public:
+    /**
+     * \param fileName Output file.
+     * \param bucket Bucket length.
+     */
+    ThroughputCollector(const std::string& fileName, Time bucket)
+        : m_fileName(fileName),
+          m_bucket(bucket),
+          m_started(false)
+    {
+    }
+
+    /**
+     * Add a metadata entry to the file header; call before Start.
+     *
+     * \param key Entry name.
+     * \param value Entry value.
+     */
+    template <typename T>
+    void SetMetadata(const std::string& key, const T& value)
+    {
+        NS_ABORT_MSG_IF(m_started, "ThroughputCollector metadata must be set before Start");
+        std::ostringstream entry;
+        entry << key << "=" << value;
+        m_metadata.push_back(entry.str());
+    }
+
+    /**
+     * Count the packets received by a sink as one flow.
+     *
+     * \param sink Application whose "Rx" trace source has the PacketSink
+     *        signature (Ptr<const Packet>, const Address&), e.g. a PacketSink.
+     * \return the flow index used in the output
+     */
+    uint32_t AddSink(Ptr<Application> sink)
+    {
+        m_slots.push_back(Slot{0, 0});
+        bool connected =
+            sink->TraceConnectWithoutContext("Rx", MakeBoundCallback(&Receive, &m_slots.back()));
+        NS_ABORT_MSG_UNLESS(connected,
+                            "ThroughputCollector cannot connect to the Rx trace of "
+                                << sink->GetInstanceTypeId().GetName());
+        return m_slots.size() - 1;
+    }
+
+    /**
+     * Called at the end of every bucket with the totals over all flows.
+     *
+     * \param callback Receives the bucket end time, bytes and packets.
+     */
+    void SetBucketCallback(Callback<void, Time, uint64_t, uint64_t> callback)
+    {
+        m_bucketCallback = callback;
+    }
+
+    /**
+     * Open the output file and start bucketing at the current time.
+     *
+     * \return false if the file cannot be written
+     */
+    bool Start()
+    {
+        m_output.open(m_fileName);
+        if (!m_output)
+        {
+            return false;
+        }
+        m_started = true;
+        m_output << "#";
+        for (const auto& entry : m_metadata)
+        {
+            m_output << " " << entry;
+        }
+        m_output << " bucket=" << m_bucket.GetSeconds() << "s\n"
+                 << "# time:double(s) flow:uint32 bytes:uint64 packets:uint64 "
+                    "rate:double(kbps)\n";
+        Flush();
+        return true;
+    }
+
+    /**
+     * Stop bucketing. The partial bucket in progress is not written.
+     */
+    void Stop()
+    {
+        m_flushEvent.Cancel();
+    }
+
+  private:
+    /// Counters of one flow for the current bucket.
+    struct Slot
+    {
+        uint64_t bytes;   //!< bytes received
+        uint64_t packets; //!< packets received
+    };
+
+    /**
+     * Rx trace sink.
+     *
+     * \param slot Slot of the receiving flow.
+     * \param packet Received packet.
+     * \param from Sender address.
+     */
+    static void Receive(Slot* slot, Ptr<const Packet> packet, const Address& from)
+    {
+        slot->bytes += packet->GetSize();
+        slot->packets++;
+    }
+
+    /// Write the rows of the bucket that just ended and reset the slots.
+    void Flush()
+    {
+        double now = Simulator::Now().GetSeconds();
+        double kbitPerByte = 8.0 / 1000 / m_bucket.GetSeconds();
+        uint64_t totalBytes = 0;
+        uint64_t totalPackets = 0;
+        for (uint32_t flow = 0; flow < m_slots.size(); flow++)
+        {
+            Slot& slot = m_slots[flow];
+            m_output << now << " " << flow << " " << slot.bytes << " " << slot.packets << " "
+                     << slot.bytes * kbitPerByte << "\n";
+            totalBytes += slot.bytes;
+            totalPackets += slot.packets;
+            slot = Slot{0, 0};
+        }
+        if (!m_bucketCallback.IsNull())
+        {
+            m_bucketCallback(Simulator::Now(), totalBytes, totalPackets);
+        }
+        m_flushEvent = Simulator::Schedule(m_bucket, &ThroughputCollector::Flush, this);
+    }
+
+    std::string m_fileName;              //!< output file name
+    Time m_bucket;                       //!< bucket length
+    bool m_started;                      //!< Start has been called
+    std::vector<std::string> m_metadata; //!< header entries
+    std::deque<Slot> m_slots;            //!< per-flow counters; a deque keeps their addresses
+    std::ofstream m_output;              //!< output file
+    EventId m_flushEvent;                //!< end of the current bucket
+    Callback<void, Time, uint64_t, uint64_t> m_bucketCallback; //!< per-bucket totals
+};
+
+} // namespace ns3
+
+#endif /* THROUGHPUT_COLLECTOR_H */
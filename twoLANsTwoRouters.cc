@@ -6,6 +6,9 @@
 #include "ns3/applications-module.h"
 #include "ns3/ipv4-global-routing-helper.h"
 
+#include "flow-stats.h"
+#include "switched-lan.h"
+
 using namespace ns3;
 
 //For colorful console printing
@@ -45,19 +48,21 @@ BackoffTrace (std::string context, Ptr<const Packet> packet)
     }
 }
 
-void ClientTx (std::string context, Ptr<const Packet> packet)
+//The counters do not need the context string, so they are connected
+//without one and no path string is built per packet.
+void ClientTx (Ptr<const Packet> packet)
 {
   total_client_tx++;
 }
-void ClientRx (std::string context, Ptr<const Packet> packet)
+void ClientRx (Ptr<const Packet> packet)
 {
   total_client_rx++;
 }
-void ServerTx (std::string context, Ptr<const Packet> packet)
+void ServerTx (Ptr<const Packet> packet)
 {
   total_server_tx++;
 }
-void ServerRx (std::string context, Ptr<const Packet> packet)
+void ServerRx (Ptr<const Packet> packet)
 {
   total_server_rx++;
 }
@@ -69,12 +74,25 @@ main (int argc, char *argv[])
 
   uint32_t n1 = 4;
   uint32_t n2 = 4;
+  bool tracing = true;
+  bool flowStats = false;
+  std::string backoffTrace = "auto";
+  bool switched = false;
 
   cmd.AddValue ("n1", "Number of LAN 1 nodes", n1);
   cmd.AddValue ("n2", "Number of LAN 2 nodes", n2);
+  cmd.AddValue ("tracing", "Enable pcap and ascii traces", tracing);
+  cmd.AddValue ("flowStats", "Print per-flow loss, delay and jitter", flowStats);
+  cmd.AddValue ("backoffTrace", "Print every CSMA backoff: true, false or auto (only while n1 + n2 <= 32)", backoffTrace);
+  cmd.AddValue ("switched", "Connect each LAN through a learning switch instead of a shared bus", switched);
 
   cmd.Parse (argc, argv);
 
+  //Large LANs back off constantly; printing each one would dominate the run
+  NS_ABORT_MSG_IF (backoffTrace != "auto" && backoffTrace != "true" && backoffTrace != "false",
+                   "backoffTrace must be true, false or auto");
+  bool printBackoff = backoffTrace == "true" || (backoffTrace == "auto" && n1 + n2 <= 32);
+
   //LogComponentEnable("UdpEchoClientApplication", LOG_LEVEL_INFO);
   //LogComponentEnable("UdpEchoServerApplication", LOG_LEVEL_INFO);
 
@@ -99,7 +117,17 @@ main (int argc, char *argv[])
   lan1_nodes.Add (router_nodes.Get (0));
   //Actually attaching CsmaNetDevice to all LAN 1 nodes.
   NetDeviceContainer lan1Devices;
-  lan1Devices = csma1.Install (lan1_nodes);
+  if (switched)
+    {
+      //Every node gets its own (still half-duplex) CSMA link to a
+      //learning bridge; a known unicast frame reaches two devices
+      //instead of the whole LAN.
+      lan1Devices = InstallSwitchedLan (csma1, lan1_nodes, CreateObject<Node> ());
+    }
+  else
+    {
+      lan1Devices = csma1.Install (lan1_nodes);
+    }
 
   //Doing the same for LAN 2
   CsmaHelper csma2;
@@ -109,7 +137,14 @@ main (int argc, char *argv[])
   lan2_nodes.Add (router_nodes.Get (1));
 
   NetDeviceContainer lan2Devices;
-  lan2Devices = csma2.Install (lan2_nodes);
+  if (switched)
+    {
+      lan2Devices = InstallSwitchedLan (csma2, lan2_nodes, CreateObject<Node> ());
+    }
+  else
+    {
+      lan2Devices = csma2.Install (lan2_nodes);
+    }
 
   /* So far our two LANs are disjoint, r1 and r2 need to be connected */
   //A PointToPoint connection between the two routers
@@ -161,21 +196,35 @@ main (int argc, char *argv[])
   //For routers to be able to forward packets, they need to have routing rules.
   Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
 
-  csma1.EnablePcap("lan1", lan1Devices);
-  csma2.EnablePcap("lan2", lan2Devices);
-  pointToPoint.EnablePcapAll("routers");
-  pointToPoint.EnableAscii("ascii-p2p", router_nodes);
+  Ptr<FlowStats> stats;
+  if (flowStats)
+    {
+      stats = Create<FlowStats> ();
+      stats->Install (NodeContainer (lan1_nodes, lan2_nodes));
+    }
+
+  if (tracing)
+    {
+      csma1.EnablePcap("lan1", lan1Devices);
+      csma2.EnablePcap("lan2", lan2Devices);
+      pointToPoint.EnablePcapAll("routers");
+      pointToPoint.EnableAscii("ascii-p2p", router_nodes);
+    }
 
   //Config::Connect("/NodeList/*/DeviceList/*/$ns3::PointToPointNetDevice/TxQueue/PacketsInQueue", MakeCallback(&CheckQueueSize));
   //Config::Connect("/NodeList/*/DeviceList/*/$ns3::CsmaNetDevice/TxQueue/PacketsInQueue", MakeCallback(&CheckQueueSize));
 
 
-  Config::Connect("/NodeList/*/DeviceList/*/$ns3::CsmaNetDevice/MacTxBackoff", MakeCallback(&BackoffTrace));
+  //Printing every backoff costs far more than the backoff itself on large LANs
+  if (printBackoff)
+    {
+      Config::Connect("/NodeList/*/DeviceList/*/$ns3::CsmaNetDevice/MacTxBackoff", MakeCallback(&BackoffTrace));
+    }
 
-  Config::Connect("/NodeList/*/ApplicationList/*/$ns3::UdpEchoClient/Tx", MakeCallback(&ClientTx));
-  Config::Connect("/NodeList/*/ApplicationList/*/$ns3::UdpEchoClient/Rx", MakeCallback(&ClientRx));
-  //Config::Connect("/NodeList/*/ApplicationList/*/$ns3::UdpEchoServer/Tx", MakeCallback(&ServerTx));
-  Config::Connect("/NodeList/*/ApplicationList/*/$ns3::UdpEchoServer/Rx", MakeCallback(&ServerRx));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::UdpEchoClient/Tx", MakeCallback(&ClientTx));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::UdpEchoClient/Rx", MakeCallback(&ClientRx));
+  //Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::UdpEchoServer/Tx", MakeCallback(&ServerTx));
+  Config::ConnectWithoutContext("/NodeList/*/ApplicationList/*/$ns3::UdpEchoServer/Rx", MakeCallback(&ServerRx));
 
 
 
@@ -184,6 +233,10 @@ main (int argc, char *argv[])
 
   std::cout << "Client Tx: " << total_client_tx << "\tClient Rx: " << total_client_rx << std::endl;
   std::cout << "Server Rx: " << total_server_rx << std::endl;
+  if (stats)
+    {
+      stats->Report (std::cout, Simulator::Now ());
+    }
 
   Simulator::Destroy ();
   return 0;
@@ -5,6 +5,13 @@
 #include "ns3/mobility-module.h"
 #include "ns3/applications-module.h"
 
+#include "event-profiler.h"
+#include "fused-propagation-loss-model.h"
+#include "ladder-scheduler.h"
+#include "parallel-runs.h"
+
+#include <fstream>
+
 using namespace ns3;
 
 NS_LOG_COMPONENT_DEFINE ("WifiV2VDemo");
@@ -29,6 +36,9 @@ public:
     m_peer = Address ();
     m_packetSize = 200;  // BSM paket boyutu (byte)
     m_interval = Seconds (0.1);  // BSM gönderim sıklığı (100ms)
+    // Periyodik olay bir kez oluşturulur ve her periyotta yeniden planlanır;
+    // her Schedule çağrısında yeni EventImpl ayrılmaz
+    m_sendEvent = Ptr<EventImpl> (MakeEvent (&BsmApplication::SendBsm, this), false);
   }
 
   ~BsmApplication() override
@@ -91,7 +101,7 @@ private:
                 << "s: " << msg.str());
 
     // Bir sonraki BSM'i planla
-    Simulator::Schedule (m_interval, &BsmApplication::SendBsm, this);
+    Simulator::Schedule (m_interval, m_sendEvent);
   }
 
 private:
@@ -99,6 +109,7 @@ private:
   Address m_peer;
   uint32_t m_packetSize;
   Time m_interval;
+  Ptr<EventImpl> m_sendEvent;
 };
 
 // Özel mesajlaşma uygulaması
@@ -121,6 +132,7 @@ public:
     m_peer = Address ();
     m_packetSize = 100;
     m_interval = Seconds (1.0);  // Her saniye mesaj gönder
+    m_sendEvent = Ptr<EventImpl> (MakeEvent (&PrivateMessageApplication::SendPrivateMessage, this), false);
   }
 
   void SetRemote (Address ip, uint16_t port)
@@ -164,7 +176,7 @@ private:
                 << " özel mesaj gönderdi at " << Simulator::Now ().GetSeconds () 
                 << "s: " << msg);
 
-    Simulator::Schedule (m_interval, &PrivateMessageApplication::SendPrivateMessage, this);
+    Simulator::Schedule (m_interval, m_sendEvent);
   }
 
 private:
@@ -172,20 +184,47 @@ private:
   Address m_peer;
   uint32_t m_packetSize;
   Time m_interval;
+  Ptr<EventImpl> m_sendEvent;
 };
 
-int
-main (int argc, char *argv[])
+/**
+ * Otoyol senaryosunu kurar, çalıştırır ve yok eder.
+ *
+ * \param nVehicles Araç sayısı (en az 2)
+ * \param nLanes Şerit sayısı
+ * \param scheduler Olay zamanlayıcı TypeId
+ * \param verbose BSM loglarını yazdır
+ * \param maxRange Alım menzili (metre); 0 ise sınırsız
+ * \param profileFile Olay profili dosyası; boş ise profil çıkarılmaz
+ */
+static void
+RunHighway (uint32_t nVehicles, uint32_t nLanes, const std::string &scheduler, bool verbose,
+            double maxRange, const std::string &profileFile)
 {
-  CommandLine cmd;
-  cmd.Parse (argc, argv);
+  // Periyodik BSM olayları için ladder queue O(1) amortize ekleme/çıkarma sağlar
+  ObjectFactory schedulerFactory;
+  if (profileFile.empty ())
+    {
+      schedulerFactory.SetTypeId (scheduler);
+    }
+  else
+    {
+      // Seçilen zamanlayıcı korunur; rapor Simulator::Destroy'da yazılır
+      schedulerFactory.SetTypeId ("ns3::ProfilingScheduler");
+      schedulerFactory.Set ("InnerScheduler", StringValue (scheduler));
+      schedulerFactory.Set ("ProfileFile", StringValue (profileFile));
+    }
+  Simulator::SetScheduler (schedulerFactory);
 
   // Logging'i etkinleştir
-  LogComponentEnable ("WifiV2VDemo", LOG_LEVEL_INFO);
+  if (verbose)
+    {
+      LogComponentEnable ("WifiV2VDemo", LOG_LEVEL_INFO);
+    }
 
-  // Düğümleri oluştur (5 araç)
+  // Düğümleri oluştur
   NodeContainer nodes;
-  nodes.Create (5);
+  nodes.Create (nVehicles);
 
   // Hareket modelini oluştur
   MobilityHelper mobility;
@@ -193,33 +232,18 @@ main (int argc, char *argv[])
   mobility.Install (nodes);
 
   // Araçların başlangıç pozisyonlarını ve hızlarını ayarla
-  // Her araç farklı şeritte ve farklı hızda hareket ediyor
+  // Araçlar 30 m arayla dizilir ve şeritlere sırayla dağıtılır; sol şerit en hızlı.
+  // Varsayılan 5 araç / 5 şeritte her araç kendi şeridindedir.
   double laneWidth = 4.0; // Şerit genişliği (metre)
-  
-  // Araç 1: En sol şeritte, en hızlı
-  Ptr<ConstantVelocityMobilityModel> mov1 = nodes.Get (0)->GetObject<ConstantVelocityMobilityModel> ();
-  mov1->SetPosition (Vector (0.0, 0.0, 0.0));
-  mov1->SetVelocity (Vector (25.0, 0.0, 0.0));  // 90 km/h
-
-  // Araç 2: İkinci şeritte
-  Ptr<ConstantVelocityMobilityModel> mov2 = nodes.Get (1)->GetObject<ConstantVelocityMobilityModel> ();
-  mov2->SetPosition (Vector (30.0, laneWidth, 0.0));
-  mov2->SetVelocity (Vector (22.0, 0.0, 0.0));  // 79 km/h
-
-  // Araç 3: Orta şeritte
-  Ptr<ConstantVelocityMobilityModel> mov3 = nodes.Get (2)->GetObject<ConstantVelocityMobilityModel> ();
-  mov3->SetPosition (Vector (60.0, 2 * laneWidth, 0.0));
-  mov3->SetVelocity (Vector (19.0, 0.0, 0.0));  // 68 km/h
-
-  // Araç 4: Dördüncü şeritte
-  Ptr<ConstantVelocityMobilityModel> mov4 = nodes.Get (3)->GetObject<ConstantVelocityMobilityModel> ();
-  mov4->SetPosition (Vector (90.0, 3 * laneWidth, 0.0));
-  mov4->SetVelocity (Vector (17.0, 0.0, 0.0));  // 61 km/h
-
-  // Araç 5: En sağ şeritte, en yavaş
-  Ptr<ConstantVelocityMobilityModel> mov5 = nodes.Get (4)->GetObject<ConstantVelocityMobilityModel> ();
-  mov5->SetPosition (Vector (120.0, 4 * laneWidth, 0.0));
-  mov5->SetVelocity (Vector (15.0, 0.0, 0.0));  // 54 km/h
+  const double laneSpeeds[] = {25.0, 22.0, 19.0, 17.0, 15.0}; // 90, 79, 68, 61, 54 km/h
+
+  for (uint32_t i = 0; i < nVehicles; ++i)
+    {
+      uint32_t lane = i % nLanes;
+      Ptr<ConstantVelocityMobilityModel> mov = nodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ();
+      mov->SetPosition (Vector (30.0 * i, lane * laneWidth, 0.0));
+      mov->SetVelocity (Vector (laneSpeeds[lane % 5], 0.0, 0.0));
+    }
 
   // WiFi ayarlarını yapılandır
   WifiHelper wifi;
@@ -228,10 +252,20 @@ main (int argc, char *argv[])
                               "DataMode", StringValue ("OfdmRate6MbpsBW10MHz"),
                               "ControlMode", StringValue ("OfdmRate6MbpsBW10MHz"));
 
-  // Kanal oluştur
-  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  // Kanal oluştur: Default () ile aynı LogDistance + 5.9 GHz Friis zinciri,
+  // tek modelde birleştirilmiş. Sonuçlar bit bit aynı; mesafe bir kez
+  // hesaplanır ve alıcı başına iki yerine tek sanal CalcRxPower çağrısı yapılır.
+  YansWifiChannelHelper wifiChannel;
   wifiChannel.SetPropagationDelay ("ns3::ConstantSpeedPropagationDelayModel");
-  wifiChannel.AddPropagationLoss ("ns3::FriisPropagationLossModel", "Frequency", DoubleValue (5.9e9));
+  wifiChannel.AddPropagationLoss ("ns3::LogDistanceFriisPropagationLossModel",
+                                  "Frequency", DoubleValue (5.9e9));
+  if (maxRange > 0)
+    {
+      // Menzil dışındaki sinyaller -1000 dBm olur ve YansWifiChannel onları
+      // RxSensitivity kontrolünde düşürür: alıcının InterferenceHelper olay
+      // listesi yoğunlukla değil, yalnızca menzil içi komşu sayısıyla büyür.
+      wifiChannel.AddPropagationLoss ("ns3::RangePropagationLossModel", "MaxRange", DoubleValue (maxRange));
+    }
   Ptr<YansWifiChannel> channel = wifiChannel.Create ();
 
   // WiFi cihazlarını oluştur
@@ -245,9 +279,16 @@ main (int argc, char *argv[])
   InternetStackHelper internet;
   internet.Install (nodes);
 
-  // IP adreslerini ata
+  // IP adreslerini ata (/24 en fazla 254 araç alır)
   Ipv4AddressHelper ipv4;
-  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  if (nVehicles < 255)
+    {
+      ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+    }
+  else
+    {
+      ipv4.SetBase ("10.0.0.0", "255.0.0.0");
+    }
   Ipv4InterfaceContainer interfaces = ipv4.Assign (devices);
 
   // BSM uygulamalarını oluştur
@@ -281,6 +322,59 @@ main (int argc, char *argv[])
   Simulator::Stop (Seconds (21.0));
   Simulator::Run ();
   Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string scheduler = "ns3::MapScheduler";
+  uint32_t nVehicles = 5;
+  uint32_t nLanes = 5;
+  bool verbose = true;
+  uint32_t runs = 1;
+  uint32_t workers = 0;
+  double maxRange = 0;
+  bool profile = false;
+
+  CommandLine cmd;
+  cmd.AddValue ("scheduler", "Olay zamanlayıcı TypeId (ör. ns3::LadderScheduler)", scheduler);
+  cmd.AddValue ("nVehicles", "Araç sayısı (en az 2)", nVehicles);
+  cmd.AddValue ("nLanes", "Şerit sayısı", nLanes);
+  cmd.AddValue ("verbose", "BSM ve özel mesaj loglarını yazdır", verbose);
+  cmd.AddValue ("runs", "Bağımsız tekrar sayısı (RngRun, RngRun+1, ...)", runs);
+  cmd.AddValue ("workers", "Paralel worker process sayısı (0: tüm çekirdekler)", workers);
+  cmd.AddValue ("maxRange", "Alım menzili (metre, ör. 300); 0 ise sınırsız", maxRange);
+  cmd.AddValue ("profile", "Olay gerçekleme tipi başına süre profilini çıkar (*.folded)",
+                profile);
+  cmd.Parse (argc, argv);
+
+  if (nVehicles < 2 || nLanes == 0)
+    {
+      NS_FATAL_ERROR ("nVehicles must be at least 2 and nLanes at least 1");
+    }
+  NS_ABORT_MSG_IF (runs == 0, "runs must be at least 1");
+
+  if (runs == 1)
+    {
+      RunHighway (nVehicles, nLanes, scheduler, verbose, maxRange,
+                  profile ? "wifi-v2v-demo.folded" : "");
+      return 0;
+    }
 
-  return 0;
-} 
\ No newline at end of file
+  // Tekrarlar ayrı process'lerde koşar; her biri aynı RngRun ile tek başına
+  // çalıştırılmış hâliyle birebir aynı çıktıyı üretir. Bu yalnızca tekrar
+  // sayısını paralelleştirir: tek bir büyük koşu yine tek çekirdekte çalışır.
+  uint64_t baseRun = RngSeedManager::GetRun ();
+  uint32_t failed = RunInWorkers (runs, workers, [&] (uint32_t k) {
+      std::string run = "wifi-v2v-demo-run" + std::to_string (baseRun + k);
+      std::ofstream out (run + ".log");
+      std::streambuf *saved = std::clog.rdbuf (out.rdbuf ());
+      RngSeedManager::SetRun (baseRun + k);
+      RunHighway (nVehicles, nLanes, scheduler, verbose, maxRange,
+                  profile ? run + ".folded" : "");
+      std::clog.rdbuf (saved);
+      return 0;
+    });
+
+  return failed == 0 ? 0 : 1;
+}